@@ -150,6 +150,12 @@ class actor : public channel {
      */
     inline bool is_proxy() const;
 
+    /**
+     * @brief Returns the number of messages in the mailbox of this actor.
+     * @note This member function is lock-free and cheap enough to be
+     *       called before each send. Proxies always return 0.
+     */
+    virtual size_t mailbox_size() const;
 
  protected:
 
@@ -37,7 +37,6 @@ enum class actor_state : int {
     ready,
     done,
     blocked,
-    pending,
     about_to_block
 };
 
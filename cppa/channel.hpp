@@ -43,6 +43,7 @@ class actor;
 class group;
 class any_tuple;
 class message_header;
+class scheduled_actor;
 
 typedef intrusive_ptr<actor> actor_ptr;
 
@@ -66,16 +67,14 @@ class channel : public ref_counted {
 
 
     /**
-     * @brief Enqueues @p msg to the list of received messages and returns
-     *        true if this is an scheduled actor that successfully changed
-     *        its state to @p pending in response to the enqueue operation.
+     * @brief Enqueues @p msg to the list of received messages but leaves
+     *        scheduling to the caller.
+     * @returns The actor that became ready in response to the enqueue
+     *          operation and must be passed to the scheduler by the caller,
+     *          or @p nullptr.
      */
-    virtual bool chained_enqueue(const message_header& hdr, any_tuple msg);
-
-    /**
-     * @brief Sets the state from @p pending to @p ready.
-     */
-    virtual void unchain();
+    virtual scheduled_actor* enqueue_batched(const message_header& hdr,
+                                             any_tuple msg);
 
  protected:
 
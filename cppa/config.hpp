@@ -60,6 +60,8 @@
 #  error Plattform and/or compiler not supportet
 #endif
 
+#define CPPA_CACHE_LINE_SIZE 64
+
 #include <memory>
 #include <cstdio>
 #include <cstdlib>
@@ -39,6 +39,7 @@
 #include <type_traits>
 
 #include "cppa/on.hpp"
+#include "cppa/on_batch.hpp"
 #include "cppa/atom.hpp"
 #include "cppa/send.hpp"
 #include "cppa/self.hpp"
@@ -45,6 +45,8 @@
 
 namespace cppa { namespace detail {
 
+class embedding;
+
 class abstract_tuple : public ref_counted {
 
  public:
@@ -63,6 +65,15 @@ class abstract_tuple : public ref_counted {
     virtual const uniform_type_info* type_at(size_t pos) const = 0;
     virtual const std::string* tuple_type_names() const = 0;
 
+    // moves the elements of this tuple to a new tuple constructed in
+    // the @p size bytes at @p storage; returns the new tuple or nullptr
+    // if it would not fit (default)
+    virtual abstract_tuple* move_to(void* storage, size_t size, embedding* owner);
+
+    // returns the object storing this tuple in its own memory
+    // or nullptr (default) if this tuple lives on the heap
+    virtual embedding* embedded_in() const;
+
     // returns either tdata<...> object or nullptr (default) if tuple
     // is not a 'native' implementation
     virtual const void* native_data() const;
@@ -35,17 +35,27 @@
 #include <mutex>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include <cstdint>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "cppa/actor.hpp"
 #include "cppa/attachable.hpp"
+#include "cppa/mailbox_stats.hpp"
 #include "cppa/util/shared_spinlock.hpp"
 
 #include "cppa/detail/singleton_mixin.hpp"
 
+namespace cppa { class mailbox_element; }
+
+namespace cppa { namespace intrusive {
+template<typename T, class Delete> class single_reader_queue;
+} } // namespace cppa::intrusive
+
 namespace cppa { namespace detail {
 
+struct disposer;
 class singleton_manager;
 
 class actor_registry : public singleton_mixin<actor_registry> {
@@ -89,6 +99,25 @@ class actor_registry : public singleton_mixin<actor_registry> {
     // blocks the caller until running-actors-count becomes @p expected
     void await_running_count_equal(size_t expected);
 
+    typedef intrusive::single_reader_queue<mailbox_element, disposer>
+            mailbox_type;
+
+    // makes the mailbox of a local actor visible to largest_mailboxes(),
+    // ignores closed mailboxes
+    void add_mailbox(actor_id key, const mailbox_type* mbox);
+
+    // must be called after closing and before destroying the mailbox
+    void remove_mailbox(actor_id key);
+
+    /**
+     * @brief Returns the counters of the @p n local actors with
+     *        the most messages in their mailbox in descending order.
+     * @note Mailboxes are registered when a message first arrives at
+     *       a non-empty mailbox, i.e., actors that never had more
+     *       than one message in their mailbox are not reported.
+     */
+    std::vector<mailbox_stats> largest_mailboxes(size_t n) const;
+
  private:
 
     typedef std::map<actor_id, value_type> entries;
@@ -102,6 +131,9 @@ class actor_registry : public singleton_mixin<actor_registry> {
     mutable util::shared_spinlock m_instances_mtx;
     entries m_entries;
 
+    mutable util::shared_spinlock m_mailboxes_mtx;
+    std::unordered_map<actor_id, const mailbox_type*> m_mailboxes;
+
     actor_registry();
 
 };
@@ -0,0 +1,63 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+#ifndef CPPA_BACKPRESSURE_HPP
+#define CPPA_BACKPRESSURE_HPP
+
+#include <vector>
+
+#include "cppa/actor.hpp"
+#include "cppa/message_id.hpp"
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief Sends <tt>{'OVERFLOW', receiver}</tt> to @p sender,
+ *        as response message if @p mid is a synchronous request.
+ */
+void notify_overflow(const actor_ptr& receiver,
+                     const actor_ptr& sender,
+                     const message_id& mid);
+
+/**
+ * @brief Suspends @p sender after its current message if it is the
+ *        event-based actor running in the calling thread.
+ * @returns @p sender on success, @p nullptr otherwise.
+ */
+actor_ptr suspend_sender(const actor_ptr& sender);
+
+/**
+ * @brief Reschedules all actors in @p senders that were suspended
+ *        by {@link suspend_sender()} and clears @p senders.
+ */
+void resume_senders(std::vector<actor_ptr>& senders);
+
+} } // namespace cppa::detail
+
+#endif // CPPA_BACKPRESSURE_HPP
@@ -0,0 +1,147 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_DETACHED_THREAD_POOL_HPP
+#define CPPA_DETACHED_THREAD_POOL_HPP
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief A cached pool of threads for detached and blocking actors.
+ *
+ * Each job runs in its own thread, since detached actors might block
+ * indefinitely. Threads that finished a job wait for the next one
+ * instead of terminating. The pool keeps at most
+ * {@link max_idle_threads()} idle threads, and idle threads exit after
+ * {@link idle_timeout()}. Therefore, spawning many short-lived actors
+ * reuses threads instead of creating a new one for each actor.
+ */
+class detached_thread_pool {
+
+ public:
+
+    typedef std::function<void()> job;
+
+    detached_thread_pool();
+
+    /**
+     * @brief Causes all idle threads to exit. Busy threads exit
+     *        as soon as their current job is done.
+     */
+    ~detached_thread_pool();
+
+    detached_thread_pool(const detached_thread_pool&) = delete;
+
+    detached_thread_pool& operator=(const detached_thread_pool&) = delete;
+
+    /**
+     * @brief Runs @p fun in an idle thread or in a new thread
+     *        if no thread is idle.
+     */
+    void run(job fun);
+
+    /**
+     * @brief Sets the stack size of new threads in bytes;
+     *        0 selects the default of the platform.
+     * @note Ignored on platforms without POSIX threads.
+     */
+    void stack_size(size_t value);
+
+    size_t stack_size() const;
+
+    void max_idle_threads(size_t value);
+
+    size_t max_idle_threads() const;
+
+    void idle_timeout(std::chrono::milliseconds value);
+
+    std::chrono::milliseconds idle_timeout() const;
+
+    /**
+     * @brief Returns the number of running threads, including idle ones.
+     */
+    size_t num_threads() const;
+
+    /**
+     * @brief Returns the number of threads waiting for a job.
+     */
+    size_t num_idle_threads() const;
+
+    /**
+     * @brief Returns the maximum number of threads that ran concurrently.
+     */
+    size_t peak_threads() const;
+
+    /**
+     * @brief Returns how many threads this pool has created so far.
+     */
+    std::uint64_t created_threads() const;
+
+ private:
+
+    // shared with all threads, since busy threads
+    // might outlive the pool object
+    struct state {
+        mutable std::mutex mtx;
+        std::condition_variable cv;
+        std::deque<job> jobs;
+        size_t stack_size;
+        size_t max_idle;
+        std::chrono::milliseconds idle_timeout;
+        size_t threads;
+        size_t idle;
+        size_t peak;
+        std::uint64_t created;
+        bool shutdown;
+    };
+
+    typedef std::shared_ptr<state> state_ptr;
+
+    static void thread_loop(state_ptr st);
+
+    // called with st->mtx locked
+    static void launch(const state_ptr& st);
+
+    state_ptr m_state;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_DETACHED_THREAD_POOL_HPP
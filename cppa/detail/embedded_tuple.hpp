@@ -0,0 +1,102 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_EMBEDDED_TUPLE_HPP
+#define CPPA_EMBEDDED_TUPLE_HPP
+
+#include <utility>
+
+namespace cppa { class mailbox_element; }
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief An object that stores a tuple in its own memory.
+ * @see abstract_tuple::move_to()
+ */
+class embedding {
+
+ public:
+
+    /**
+     * @brief Called by the embedded tuple after it was destroyed, i.e.,
+     *        after the last reference to it has been released.
+     */
+    virtual void release_embedded() = 0;
+
+    /**
+     * @brief Returns the mailbox element storing the embedded tuple and
+     *        hands it over to the caller if nobody claimed it so far, i.e.,
+     *        if the element was created for the tuple alone, otherwise
+     *        @p nullptr.
+     * @see mailbox_element::make_embedded()
+     */
+    virtual mailbox_element* claim_element() = 0;
+
+ protected:
+
+    ~embedding() = default;
+
+};
+
+/**
+ * @brief A tuple that lives in the memory of an {@link embedding}
+ *        rather than on the heap.
+ */
+template<class Tuple>
+class embedded_tuple : public Tuple {
+
+ public:
+
+    template<typename... Ts>
+    embedded_tuple(embedding* owner, Ts&&... args)
+    : Tuple(std::forward<Ts>(args)...), m_owner(owner) { }
+
+    embedding* embedded_in() const override {
+        return m_owner;
+    }
+
+ protected:
+
+    void request_deletion() {
+        auto owner = m_owner;
+        this->~embedded_tuple();
+        owner->release_embedded();
+    }
+
+ private:
+
+    embedding* m_owner;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_EMBEDDED_TUPLE_HPP
@@ -32,11 +32,12 @@
 #define CPPA_MEMORY_HPP
 
 #include <new>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <utility>
-#include <typeinfo>
 #include <iostream>
+#include <algorithm>
 
 #include "cppa/config.hpp"
 #include "cppa/ref_counted.hpp"
@@ -47,12 +48,76 @@ namespace cppa { namespace detail {
 
 namespace {
 
-constexpr size_t s_alloc_size   = 1024*1024;    // allocate ~1mb chunks
-constexpr size_t s_cache_size   = 10*1024*1024; // cache about 10mb per thread
-constexpr size_t s_min_elements = 5;            // don't create < 5 elements
+constexpr size_t s_min_elements = 5;  // don't create < 5 elements
+constexpr size_t s_return_batch = 64; // return elements in batches
 
 } // namespace <anonymous>
 
+/**
+ * @brief Configures the per-thread memory caches.
+ * @see memory::configure()
+ */
+struct memory_settings {
+
+    memory_settings();
+
+    /**
+     * @brief Number of bytes a cache allocates at once, 1MB by default.
+     */
+    size_t alloc_size;
+
+    /**
+     * @brief Maximum number of bytes a thread caches per type
+     *        or size class, 10MB by default.
+     */
+    size_t cache_size;
+
+    /**
+     * @brief Ascending block sizes of the slabs used for message contents;
+     *        larger objects are allocated with global @p new.
+     *        Default: 32, 64, 128, 256, and 512 bytes.
+     */
+    std::vector<size_t> size_classes;
+
+};
+
+/**
+ * @brief Counts how often the memory caches of a thread handed out
+ *        memory and how often they had to allocate new storage.
+ * @see memory::thread_counters()
+ */
+struct memory_counters {
+
+    memory_counters();
+
+    /**
+     * @brief Number of objects created via {@link memory::create()}.
+     */
+    size_t instances;
+
+    /**
+     * @brief Number of blocks handed out by {@link memory::allocate()}.
+     */
+    size_t blocks;
+
+    /**
+     * @brief Number of allocations with global @p new, i.e., storage
+     *        chunks and blocks exceeding all size classes.
+     */
+    size_t chunks;
+
+    /**
+     * @brief Number of objects and blocks released by other
+     *        threads that were taken back by their owning cache.
+     */
+    size_t returned;
+
+    memory_counters& operator+=(const memory_counters& other);
+
+};
+
+class memory_cache;
+
 struct disposer {
     inline void operator()(memory_managed* ptr) const {
         ptr->request_deletion();
@@ -71,6 +136,9 @@ class instance_wrapper {
     // releases memory
     virtual void deallocate() = 0;
 
+    // returns the cache of the calling thread for this instance's type
+    virtual memory_cache* thread_cache() = 0;
+
 };
 
 class memory_cache {
@@ -84,9 +152,14 @@ class memory_cache {
 
     virtual std::pair<instance_wrapper*, void*> new_instance() = 0;
 
+    // makes sure the next @p num calls to new_instance() don't allocate
+    virtual void reserve(size_t num) = 0;
+
     // casts @p ptr to the derived type and returns it
     virtual void* downcast(memory_managed* ptr) = 0;
 
+    memory_counters counters;
+
 };
 
 class instance_wrapper;
@@ -111,50 +184,189 @@ class memory {
         return new T (std::forward<Ts>(args)...);
     }
 
-    static inline memory_cache* get_cache_map_entry(const std::type_info*) {
-        return nullptr;
+    template<typename T>
+    static inline void reserve(size_t) { }
+
+    static inline void* allocate(size_t size) {
+        return ::operator new(size);
+    }
+
+    static inline void deallocate(void* ptr, size_t) {
+        ::operator delete(ptr);
     }
 
+    static void configure(memory_settings settings);
+
+    static const memory_settings& settings();
+
+    // always returns zero counters, since there are no caches
+    static memory_counters thread_counters();
+
 };
 
 #else // CPPA_DISABLE_MEM_MANAGEMENT
 
+/*
+ * Each thread has its own caches. Memory is usually released by another
+ * thread than the one that allocated it, e.g., mailbox elements are created
+ * by the sender and released by the receiver. Hence, a cache returns
+ * elements it did not allocate to the owning cache in batches of
+ * s_return_batch elements. The owner takes returned elements once its local
+ * elements run out. Otherwise, a thread that only allocates would keep
+ * allocating storage while a thread that only releases would hoard elements.
+ *
+ * A node type used with returned_list has a @p next pointer and a member
+ * function @p deallocate() releasing the node's reference to its storage.
+ */
+
+// a lock-free stack of nodes returned by other threads,
+// outlives its cache as long as any of its nodes is alive
+template<class Node>
+class returned_list : public ref_counted {
+
+ public:
+
+    returned_list() : m_head(nullptr) { }
+
+    // returns false if the owning cache has been destroyed
+    bool push(Node* first, Node* last) {
+        auto e = m_head.load();
+        for (;;) {
+            if (e == closed_tag()) return false;
+            last->next = e;
+            if (m_head.compare_exchange_weak(e, first)) return true;
+        }
+    }
+
+    // called by the owning cache only
+    inline Node* take_all() {
+        return m_head.exchange(nullptr);
+    }
+
+    // called by the owning cache on destruction,
+    // deallocates all nodes returned so far
+    inline void close() {
+        deallocate_all(m_head.exchange(closed_tag()));
+    }
+
+    static void deallocate_all(Node* first) {
+        while (first != nullptr) {
+            auto next = first->next;
+            first->deallocate();
+            first = next;
+        }
+    }
+
+ private:
+
+    inline Node* closed_tag() {
+        return reinterpret_cast<Node*>(this);
+    }
+
+    std::atomic<Node*> m_head;
+
+};
+
+// collects nodes released by this thread that are owned by other caches
+template<class Node>
+class returned_batches {
+
+ public:
+
+    typedef returned_list<Node> list_type;
+
+    ~returned_batches() {
+        for (auto& batch : m_batches) flush(batch);
+    }
+
+    void add(list_type* owner, Node* node) {
+        auto i = std::find_if(m_batches.begin(), m_batches.end(),
+                              [=](const batch& b) { return b.owner == owner; });
+        if (i == m_batches.end()) {
+            node->next = nullptr;
+            m_batches.push_back(batch{owner, node, node, 1});
+            i = m_batches.end() - 1;
+        }
+        else {
+            node->next = i->first;
+            i->first = node;
+            ++i->size;
+        }
+        if (i->size >= s_return_batch) {
+            flush(*i);
+            m_batches.erase(i);
+        }
+    }
+
+ private:
+
+    // the nodes of a batch keep their owner alive
+    struct batch {
+        list_type* owner;
+        Node* first;
+        Node* last;
+        size_t size;
+    };
+
+    static void flush(batch& b) {
+        if (!b.owner->push(b.first, b.last)) {
+            // the owning thread is gone
+            b.last->next = nullptr;
+            list_type::deallocate_all(b.first);
+        }
+    }
+
+    std::vector<batch> m_batches;
+
+};
+
 template<typename T>
 class basic_memory_cache : public memory_cache {
 
     struct wrapper : instance_wrapper {
         ref_counted* parent;
+        wrapper* next; // links elements returned to the owning cache
         union { T instance; };
-        wrapper() : parent(nullptr) { }
+        wrapper() : parent(nullptr), next(nullptr) { }
         ~wrapper() { }
         void destroy() { instance.~T(); }
         void deallocate() { parent->deref(); }
+        memory_cache* thread_cache();
     };
 
-    class storage : public ref_counted {
+    typedef returned_list<wrapper> list_type;
 
-        static constexpr size_t ne = s_alloc_size / sizeof(T);
-        static constexpr size_t dsize = ne > s_min_elements ? ne : s_min_elements;
+    class storage : public ref_counted {
 
      public:
 
-        storage() {
-            for (auto& elem : data) {
+        storage(list_type* owner, size_t size)
+        : m_owner(owner), m_size(size), m_data(new wrapper[size]) {
+            m_owner->ref();
+            for (auto& elem : *this) {
                 // each instance has a reference to its parent
                 elem.parent = this;
                 ref(); // deref() is called in wrapper::deallocate
             }
         }
 
+        ~storage() {
+            m_owner->deref();
+        }
+
         typedef wrapper* iterator;
 
-        iterator begin() { return data; }
+        iterator begin() { return m_data.get(); }
+
+        iterator end() { return begin() + m_size; }
 
-        iterator end() { return begin() + dsize; }
+        inline list_type* owner() const { return m_owner; }
 
      private:
 
-        wrapper data[dsize];
+        list_type* m_owner;
+        size_t m_size;
+        std::unique_ptr<wrapper[]> m_data;
 
     };
 
@@ -162,12 +374,12 @@ class basic_memory_cache : public memory_cache {
 
     std::vector<wrapper*> cached_elements;
 
-    basic_memory_cache() {
-        cached_elements.reserve(s_cache_size / sizeof(T));
-    }
+    basic_memory_cache();
 
     ~basic_memory_cache() {
+        m_returned->close();
         for (auto e : cached_elements) e->deallocate();
+        m_returned->deref();
     }
 
     void* downcast(memory_managed* ptr) {
@@ -181,22 +393,51 @@ class basic_memory_cache : public memory_cache {
         CPPA_REQUIRE(ptr->outer_memory != nullptr);
         auto wptr = static_cast<wrapper*>(ptr->outer_memory);
         wptr->destroy();
-        if (cached_elements.capacity() > 0) cached_elements.push_back(wptr);
+        auto owner = static_cast<storage*>(wptr->parent)->owner();
+        if (owner != m_returned) m_batches.add(owner, wptr);
+        else if (cached_elements.size() < m_max_cached) {
+            cached_elements.push_back(wptr);
+        }
         else wptr->deallocate();
     }
 
     virtual std::pair<instance_wrapper*, void*> new_instance() {
-        if (cached_elements.empty()) {
-            auto elements = new storage;
-            for (auto i = elements->begin(); i != elements->end(); ++i) {
-                cached_elements.push_back(i);
-            }
-        }
+        ++counters.instances;
+        if (cached_elements.empty()) fetch_returned();
+        if (cached_elements.empty()) allocate_storage();
         wrapper* wptr = cached_elements.back();
         cached_elements.pop_back();
         return std::make_pair(wptr, &(wptr->instance));
     }
 
+    virtual void reserve(size_t num) {
+        if (cached_elements.size() < num) fetch_returned();
+        while (cached_elements.size() < num) allocate_storage();
+    }
+
+ private:
+
+    void allocate_storage() {
+        ++counters.chunks;
+        auto elements = new storage(m_returned, m_storage_size);
+        for (auto i = elements->begin(); i != elements->end(); ++i) {
+            cached_elements.push_back(i);
+        }
+    }
+
+    // moves all elements returned by other threads to cached_elements
+    void fetch_returned() {
+        for (auto e = m_returned->take_all(); e != nullptr; e = e->next) {
+            cached_elements.push_back(e);
+            ++counters.returned;
+        }
+    }
+
+    size_t m_storage_size;
+    size_t m_max_cached;
+    list_type* m_returned;
+    returned_batches<wrapper> m_batches;
+
 };
 
 class memory {
@@ -214,31 +455,95 @@ class memory {
      */
     template<typename T, typename... Ts>
     static T* create(Ts&&... args) {
-        auto mc = get_or_set_cache_map_entry<T>();
+        auto mc = get_cache<T>();
         auto p = mc->new_instance();
         auto result = new (p.second) T (std::forward<Ts>(args)...);
         result->outer_memory = p.first;
         return result;
     }
 
-    static memory_cache* get_cache_map_entry(const std::type_info* tinf);
-
- private:
-
-    static void add_cache_map_entry(const std::type_info* tinf, memory_cache* instance);
+    /*
+     * @brief Makes sure that the next @p num calls to @p create<T>
+     *        in the calling thread don't need to allocate memory.
+     */
+    template<typename T>
+    static inline void reserve(size_t num) {
+        get_cache<T>()->reserve(num);
+    }
 
+    /*
+     * @brief Returns the cache for @p T of the calling thread.
+     */
     template<typename T>
-    static inline memory_cache* get_or_set_cache_map_entry() {
-        auto mc = get_cache_map_entry(&typeid(T));
+    static inline memory_cache* get_cache() {
+        auto slot = cache_slot<T>();
+        auto mc = get_cache_slot(slot);
         if (!mc) {
             mc = new basic_memory_cache<T>;
-            add_cache_map_entry(&typeid(T), mc);
+            set_cache_slot(slot, mc);
         }
         return mc;
     }
 
+    /*
+     * @brief Allocates @p size bytes from the smallest fitting size class
+     *        of the calling thread or with global @p new if @p size exceeds
+     *        all size classes.
+     */
+    static void* allocate(size_t size);
+
+    /*
+     * @brief Releases @p ptr allocated by <tt>allocate(size)</tt>.
+     */
+    static void deallocate(void* ptr, size_t size);
+
+    /*
+     * @brief Replaces the settings of all memory caches.
+     * @pre Must be called before any actor is spawned
+     *      and before any message is created.
+     */
+    static void configure(memory_settings settings);
+
+    static const memory_settings& settings();
+
+    /*
+     * @brief Returns the sum of the counters of all caches
+     *        of the calling thread.
+     */
+    static memory_counters thread_counters();
+
+ private:
+
+    // each cached type has a dense index into the per-thread cache array
+    template<typename T>
+    static inline size_t cache_slot() {
+        static size_t result = next_cache_slot();
+        return result;
+    }
+
+    static size_t next_cache_slot();
+
+    // returns the cache in @p slot of the calling thread or nullptr
+    static memory_cache* get_cache_slot(size_t slot);
+
+    static void set_cache_slot(size_t slot, memory_cache* instance);
+
 };
 
+template<typename T>
+memory_cache* basic_memory_cache<T>::wrapper::thread_cache() {
+    return memory::get_cache<T>();
+}
+
+template<typename T>
+basic_memory_cache<T>::basic_memory_cache() : m_returned(new list_type) {
+    auto& cfg = memory::settings();
+    m_storage_size = std::max(cfg.alloc_size / sizeof(T), s_min_elements);
+    m_max_cached = cfg.cache_size / sizeof(T);
+    m_returned->ref();
+    cached_elements.reserve(m_max_cached);
+}
+
 #endif // CPPA_DISABLE_MEM_MANAGEMENT
 
 } } // namespace cppa::detail
@@ -31,8 +31,9 @@
 #ifndef CPPA_NESTABLE_RECEIVE_POLICY_HPP
 #define CPPA_NESTABLE_RECEIVE_POLICY_HPP
 
-#include <list>
+#include <vector>
 #include <memory>
+#include <cstdint>
 #include <iostream>
 #include <type_traits>
 
@@ -50,6 +51,8 @@
 
 #include "cppa/util/scope_guard.hpp"
 
+#include "cppa/intrusive/singly_linked_list.hpp"
+
 namespace cppa { namespace detail {
 
 enum receive_policy_flag {
@@ -77,39 +80,29 @@ class receive_policy {
         hm_msg_handled
     };
 
+    receive_policy() : m_num_responses(0) { }
+
     template<class Client, class Fun>
     bool invoke_from_cache(Client* client,
                            Fun& fun,
                            message_id awaited_response = message_id{}) {
-        std::integral_constant<receive_policy_flag, Client::receive_flag> policy;
-        auto i = m_cache.begin();
-        auto e = m_cache.end();
-        while (i != e) {
-            switch (this->handle_message(client, i->get(), fun,
-                                         awaited_response, policy)) {
-                case hm_msg_handled: {
-                    m_cache.erase(i);
-                    return true;
-                }
-                case hm_drop_msg: {
-                    i = m_cache.erase(i);
-                    break;
-                }
-                case hm_skip_msg:
-                case hm_cache_msg: {
-                    ++i;
-                    break;
-                }
-                default: {
-                    CPPA_CRITICAL("illegal result of handle_message");
-                }
-            }
+        // an actor waiting for a response does not handle any ordinary
+        // message, while cached responses are only handled when awaited
+        if (awaited_response.valid()) {
+            if (m_num_responses == 0) return false;
+            return invoke_from_cache(client, fun, awaited_response,
+                                     responses_of(awaited_response));
         }
-        return false;
+        return invoke_from_cache(client, fun, awaited_response, m_cache);
+    }
+
+    inline bool cache_empty() const {
+        return m_cache.empty() && m_num_responses == 0;
     }
 
-    inline void add_to_cache(pointer node_ptr) {
-        m_cache.emplace_back(std::move(node_ptr));
+    void add_to_cache(pointer node_ptr) {
+        if (node_ptr->mid.is_response()) add_response(node_ptr);
+        else m_cache.push_back(node_ptr);
     }
 
     template<class Client, class Fun>
@@ -128,7 +121,7 @@ class receive_policy {
                 break;
             }
             case hm_cache_msg: {
-                m_cache.emplace_back(std::move(node));
+                add_to_cache(node.release());
                 break;
             }
             case hm_skip_msg: {
@@ -213,7 +206,101 @@ class receive_policy {
 
  private:
 
-    std::list<std::unique_ptr<mailbox_element, disposer> > m_cache;
+    typedef intrusive::singly_linked_list<mailbox_element, disposer> cache_type;
+
+    // skipped ordinary messages in order of arrival
+    cache_type m_cache;
+
+    // skipped synchronous responses, hashed by their message ID
+    std::vector<cache_type> m_responses;
+    size_t m_num_responses;
+
+    // we handle at most one message, but might drop any number of messages;
+    // handlers can receive messages on their own (nestable policy), which
+    // modifies the cache and invalidates all pointers except 'node'
+    template<class Client, class Fun>
+    bool invoke_from_cache(Client* client,
+                           Fun& fun,
+                           message_id awaited_response,
+                           cache_type& cache) {
+        std::integral_constant<receive_policy_flag, Client::receive_flag> policy;
+        pointer pred = nullptr;
+        pointer node = cache.front();
+        while (node) {
+            if (awaited_response.valid() && node->mid != awaited_response) {
+                pred = node;
+                node = node->next;
+                continue;
+            }
+            switch (this->handle_message(client, node, fun,
+                                         awaited_response, policy)) {
+                case hm_msg_handled: {
+                    if (awaited_response.valid()) {
+                        // any other message with this ID is expired now
+                        remove_responses(awaited_response);
+                    }
+                    else m_cache.erase(node);
+                    return true;
+                }
+                case hm_drop_msg: {
+                    if (awaited_response.valid()) --m_num_responses;
+                    node = cache.erase_after(pred);
+                    break;
+                }
+                case hm_skip_msg:
+                case hm_cache_msg: {
+                    pred = node;
+                    node = node->next;
+                    break;
+                }
+                default: {
+                    CPPA_CRITICAL("illegal result of handle_message");
+                }
+            }
+        }
+        return false;
+    }
+
+    inline cache_type& responses_of(message_id mid) {
+        auto id = mid.request_id().integer_value();
+        return m_responses[static_cast<size_t>(id) & (m_responses.size() - 1)];
+    }
+
+    void add_response(pointer node_ptr) {
+        static constexpr size_t min_buckets = 8;
+        if (m_responses.empty()) m_responses.resize(min_buckets);
+        else if (m_num_responses >= m_responses.size() * 2) {
+            // rehash; keeps responses with the same ID in arrival order
+            std::vector<cache_type> tmp(m_responses.size() * 2);
+            m_responses.swap(tmp);
+            for (auto& bucket : tmp) {
+                for (auto e = bucket.take_after(nullptr);
+                     e != nullptr;
+                     e = bucket.take_after(nullptr)) {
+                    responses_of(e->mid).push_back(e);
+                }
+            }
+        }
+        responses_of(node_ptr->mid).push_back(node_ptr);
+        ++m_num_responses;
+    }
+
+    void remove_responses(message_id mid) {
+        if (m_num_responses == 0) return;
+        auto& bucket = responses_of(mid);
+        pointer pred = nullptr;
+        pointer node = bucket.front();
+        while (node) {
+            if (node->mid == mid) {
+                node = bucket.erase_after(pred);
+                --m_num_responses;
+            }
+            else {
+                pred = node;
+                node = node->next;
+            }
+        }
+    }
 
     template<class Client>
     inline void handle_timeout(Client* client, behavior& bhvr) {
@@ -470,6 +557,8 @@ class receive_policy {
                 if (awaited_response.valid()) {
                     client->mark_arrived(awaited_response);
                     client->remove_handler(awaited_response);
+                    // a response arriving later on is expired
+                    remove_responses(awaited_response);
                 }
                 return hm_msg_handled;
             }
@@ -31,11 +31,19 @@
 #ifndef CPPA_THREAD_POOL_SCHEDULER_HPP
 #define CPPA_THREAD_POOL_SCHEDULER_HPP
 
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <thread>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
 
 #include "cppa/scheduler.hpp"
 #include "cppa/context_switching_actor.hpp"
 #include "cppa/util/producer_consumer_list.hpp"
+#include "cppa/detail/detached_thread_pool.hpp"
 #include "cppa/detail/scheduled_actor_dummy.hpp"
 
 namespace cppa { namespace detail {
@@ -59,24 +67,489 @@ class thread_pool_scheduler : public scheduler {
 
     void destroy();
 
+    /**
+     * @brief Schedules @p what for execution.
+     *
+     * If the caller is a worker of this scheduler, @p what is stored in
+     * the worker's LIFO slot and runs as soon as the current actor returns,
+     * i.e., while the message that woke it is still in the cache.
+     * A job that occupied the slot before is moved to the job queue.
+     * Idle workers are woken up and steal the job from the slot, so that
+     * a pipeline of actors doesn't run serialized on a single worker.
+     */
     void enqueue(scheduled_actor* what);
 
+    /**
+     * @brief Appends all actors in @p what to the job queue
+     *        in a single operation and wakes up to
+     *        <tt>what.size()</tt> parked workers.
+     */
+    void enqueue_batch(const std::vector<scheduled_actor*>& what) override;
+
     local_actor_ptr exec(spawn_options opts, scheduled_actor_ptr ptr) override;
 
     local_actor_ptr exec(spawn_options opts, init_callback init_cb, void_function f) override;
 
- private:
+    scheduler_statistics statistics() const override;
+
+    /**
+     * @brief Causes workers to measure the time they spend running
+     *        actors and waiting for jobs.
+     * @note Without measuring, busy and idle times as well as the average
+     *       resume duration are reported as zero by {@link statistics()}.
+     */
+    inline void measure_utilization(bool value) {
+        m_measure_utilization = value;
+    }
+
+    /**
+     * @brief Checks whether workers measure busy and idle times.
+     */
+    inline bool measure_utilization() const {
+        return m_measure_utilization;
+    }
+
+    /**
+     * @brief Returns the pool of threads running detached
+     *        and blocking actors, e.g., to set their stack size.
+     */
+    inline detached_thread_pool& detached_threads() {
+        return m_detached;
+    }
+
+    /**
+     * @brief Causes the supervisor to write {@link statistics()} to
+     *        the log every @p interval; a zero interval disables logging.
+     * @pre Must be called before the scheduler is initialized.
+     */
+    inline void log_statistics(std::chrono::milliseconds interval) {
+        m_log_interval = interval;
+    }
+
+    /**
+     * @brief Causes idle workers to block until {@link enqueue} wakes
+     *        them up instead of polling the job queue with increasing
+     *        sleep intervals.
+     * @pre Must be called before the scheduler is initialized.
+     */
+    inline void park_idle_workers(bool value) {
+        m_park_idle_workers = value;
+    }
+
+    /**
+     * @brief Checks whether idle workers block instead of polling.
+     */
+    inline bool park_idle_workers() const {
+        return m_park_idle_workers;
+    }
+
+    /**
+     * @brief Sets the number of dequeue attempts an idle worker makes
+     *        before it either parks or starts to sleep between attempts.
+     * @pre Must be called before the scheduler is initialized.
+     */
+    inline void spin_budget(size_t value) {
+        m_spin_budget = value;
+    }
+
+    /**
+     * @brief Returns the number of dequeue attempts an idle
+     *        worker makes before it parks or sleeps.
+     */
+    inline size_t spin_budget() const {
+        return m_spin_budget;
+    }
+
+    /**
+     * @brief Pins each worker thread to a CPU and distributes the
+     *        workers round-robin over all NUMA nodes of the host.
+     *
+     * Since each thread allocates mailbox elements from its own memory
+     * cache, pinned workers allocate node-local memory.
+     * @pre Must be called before the scheduler is initialized.
+     */
+    inline void pin_workers(bool value) {
+        m_pin_workers = value;
+    }
+
+    /**
+     * @brief Checks whether worker threads are pinned to CPUs.
+     */
+    inline bool pin_workers() const {
+        return m_pin_workers;
+    }
+
+    /**
+     * @brief Sets the minimum and maximum number of active workers.
+     *
+     * If @p min_workers is smaller than @p max_workers, the scheduler
+     * periodically samples job queue depth and worker utilization.
+     * It adds a worker whenever all workers are busy while jobs
+     * are waiting and retires a worker if more than one worker
+     * stays idle for a longer period.
+     * @pre Must be called before the scheduler is initialized
+     *      and <tt>0 < min_workers <= max_workers</tt>.
+     */
+    void worker_bounds(size_t min_workers, size_t max_workers);
+
+    /**
+     * @brief Pauses (@p false) or resumes (@p true) adapting the number
+     *        of active workers to the load, see {@link worker_bounds()}.
+     *        Resizing the pool is enabled by default and has no effect
+     *        if <tt>min_workers() == max_workers()</tt>.
+     * @note The supervisor does not change the number of active workers
+     *       once this member function returned @p false.
+     */
+    void adaptive_resizing(bool value);
+
+    /**
+     * @brief Checks whether the number of active workers adapts to the load.
+     */
+    inline bool adaptive_resizing() const {
+        return m_adaptive_resizing;
+    }
+
+    /**
+     * @brief Returns the minimum number of active workers.
+     */
+    inline size_t min_workers() const {
+        return m_min_workers;
+    }
+
+    /**
+     * @brief Returns the maximum number of active workers.
+     */
+    inline size_t max_workers() const {
+        return m_num_threads;
+    }
+
+    /**
+     * @brief Sets the number of active workers to @p num_workers,
+     *        clamped to <tt>[min_workers(), max_workers()]</tt>.
+     * @note Retired workers finish the job they are currently running
+     *       before they stop. Their pending jobs are handed over to
+     *       the remaining workers.
+     */
+    void resize(size_t num_workers);
+
+    /**
+     * @brief Returns the number of active workers.
+     */
+    inline size_t num_active_workers() const {
+        return m_active.load();
+    }
+
+    /**
+     * @brief Sets how many jobs a worker runs consecutively from its
+     *        LIFO slot before it moves the next one to the job queue;
+     *        0 disables the LIFO slot.
+     */
+    inline void lifo_slot_limit(size_t value) {
+        m_lifo_slot_limit.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the maximum number of consecutive LIFO slot hits.
+     */
+    inline size_t lifo_slot_limit() const {
+        return m_lifo_slot_limit.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets how often a worker passes over waiting actors of a
+     *        {@link scheduling_priority} class before it runs one of
+     *        them ahead of higher classes; 0 disables aging, i.e.,
+     *        lower classes may starve.
+     */
+    inline void aging_threshold(size_t value) {
+        m_aging_threshold.store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns how often a worker passes over waiting
+     *        actors of a lower class at most.
+     */
+    inline size_t aging_threshold() const {
+        return m_aging_threshold.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns how often parked workers were woken up by
+     *        {@link enqueue} so far.
+     */
+    inline std::uint64_t num_wakeups() const {
+        return m_wakeups.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the average time between waking up a parked worker
+     *        and the worker resuming execution.
+     */
+    std::chrono::nanoseconds avg_wakeup_latency() const;
+
+    /**
+     * @brief Returns the maximum time between waking up a parked worker
+     *        and the worker resuming execution.
+     */
+    inline std::chrono::nanoseconds max_wakeup_latency() const {
+        return std::chrono::nanoseconds(m_max_wakeup_latency.load());
+    }
+
+ protected:
 
     //typedef util::single_reader_queue<abstract_scheduled_actor> job_queue;
     typedef util::producer_consumer_list<scheduled_actor> job_queue;
 
+    /**
+     * @brief Returns the next job for @p w or @p nullptr if
+     *        no job is available at the moment.
+     * @note Called from the worker threads and during shutdown.
+     */
+    virtual scheduled_actor* try_dequeue(worker* w);
+
+    /**
+     * @brief Appends @p what to the tail of the job queue, bypassing
+     *        the LIFO slot of @p w.
+     * @param w The calling worker or @p nullptr.
+     */
+    virtual void enqueue_tail(worker* w, scheduled_actor* what);
+
+    /**
+     * @brief Appends all actors in @p what to the tail of the job queue.
+     * @param w The calling worker or @p nullptr.
+     */
+    virtual void enqueue_tail(worker* w,
+                              const std::vector<scheduled_actor*>& what);
+
+    /**
+     * @brief Returns the approximated number of jobs waiting to be run.
+     */
+    virtual size_t queued_jobs() const;
+
+    /**
+     * @brief Called from @p w before its thread stops due to
+     *        {@link resize()}; hands over all jobs owned by @p w.
+     */
+    virtual void worker_retired(worker* w);
+
+    /**
+     * @brief Returns a job from the shared queue of class @p prio
+     *        or @p nullptr if that queue is empty.
+     */
+    scheduled_actor* try_dequeue_shared(scheduling_priority prio);
+
+    /**
+     * @brief Returns the number of jobs in the shared queue of class @p prio.
+     */
+    inline size_t shared_jobs(scheduling_priority prio) const {
+        auto i = static_cast<size_t>(prio);
+        return m_shared_jobs[i].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Takes the job from the LIFO slot of another worker.
+     * @param thief The calling worker or @p nullptr.
+     * @param idle Denotes whether @p thief found no other job. Busy workers
+     *             check the LIFO slots only on every
+     *             {@link aging_threshold()}-th call, which bounds how long
+     *             a job waits in the slot of a worker that runs a long job.
+     */
+    scheduled_actor* steal_next(worker* thief, bool idle);
+
+    /**
+     * @brief Implements aging: returns @p true if @p w passed over jobs
+     *        of class @p prio {@link aging_threshold()} times in a row
+     *        and thus has to run one of them next.
+     * @param w The calling worker or @p nullptr.
+     * @param waiting Denotes whether jobs of class @p prio are waiting.
+     */
+    bool passed_over(worker* w, scheduling_priority prio, bool waiting);
+
+    /**
+     * @brief Returns the worker running in the calling thread or
+     *        @p nullptr if the caller is not a worker of this scheduler.
+     */
+    worker* current_worker() const;
+
+    /**
+     * @brief Wakes up one parked worker if there is any.
+     */
+    inline void wake_up_worker() {
+        if (m_parked.load() > 0) notify_parked(false);
+    }
+
+    /**
+     * @brief Wakes up to @p num parked workers.
+     */
+    inline void wake_up_workers(size_t num) {
+        auto parked = m_parked.load();
+        if (parked == 0 || num == 0) return;
+        if (num >= parked) notify_parked(true);
+        else for (size_t i = 0; i < num; ++i) notify_parked(false);
+    }
+
+    // returns the number of allocated (not necessarily active) workers
+    inline size_t num_workers() const {
+        return m_num_threads;
+    }
+
+    inline worker* worker_at(size_t id) const {
+        return m_workers[id].get();
+    }
+
+    static constexpr size_t num_priorities = 3;
+
     size_t m_num_threads;
-    job_queue m_queue;
+    // one shared job queue per scheduling_priority
+    job_queue m_queues[num_priorities];
     scheduled_actor_dummy m_dummy;
+
+ private:
+
+    void notify_parked(bool all);
+
+    void record_wakeup(std::int64_t parked_since);
+
+    // starts workers below and joins stopped workers above m_active,
+    // called from the supervisor thread only
+    void apply_worker_count();
+
+    // grows or shrinks the number of active workers based on the load
+    void adapt_worker_count(size_t& idle_samples);
+
+    // returns true if the number of active workers has changed
+    bool set_active_workers(size_t num_workers);
+
+    std::vector<std::unique_ptr<worker> > m_workers;
     std::thread m_supervisor;
+    detached_thread_pool m_detached;
+
+    // configuration of worker threads
+    bool m_pin_workers;
+    bool m_park_idle_workers;
+    size_t m_spin_budget;
+    std::atomic<size_t> m_lifo_slot_limit;
+    std::atomic<size_t> m_aging_threshold;
+    std::atomic<bool> m_measure_utilization;
+    std::chrono::milliseconds m_log_interval;
+
+    // workers with ID < m_active are running, all others retire
+    size_t m_min_workers;
+    std::atomic<bool> m_adaptive_resizing;
+    std::atomic<size_t> m_active;
+
+    // load measurements
+    std::atomic<size_t> m_idle;
+    std::atomic<size_t> m_shared_jobs[num_priorities];
+
+    // the supervisor waits on m_supervisor_cv for resize() or shutdown
+    std::mutex m_supervisor_mtx;
+    std::condition_variable m_supervisor_cv;
+    bool m_shutdown;
+
+    // parked workers wait on m_park_cv
+    std::mutex m_park_mtx;
+    std::condition_variable m_park_cv;
+    std::atomic<size_t> m_parked;
+
+    // time of the last notification in nanoseconds (steady clock)
+    std::atomic<std::int64_t> m_last_notify;
+
+    // wake-up latency measurements
+    std::atomic<std::uint64_t> m_wakeups;
+    std::atomic<std::int64_t> m_total_wakeup_latency;
+    std::atomic<std::int64_t> m_max_wakeup_latency;
 
     static void worker_loop(worker*);
-    static void supervisor_loop(job_queue*, scheduled_actor*, size_t);
+    static void supervisor_loop(thread_pool_scheduler*);
+
+};
+
+struct thread_pool_scheduler::worker {
+
+    typedef scheduled_actor* job_ptr;
+
+    thread_pool_scheduler* m_parent;
+    size_t m_id;
+    job_ptr m_dummy;
+    std::thread m_thread;
+
+    // NUMA node of this worker, always 0 if workers are not pinned
+    size_t m_node;
+
+    // CPU this worker is pinned to or -1
+    int m_cpu;
+
+    // job that runs next on this worker, filled by this worker only
+    // but other workers steal it if they are idle
+    std::atomic<job_ptr> m_next;
+
+    // number of jobs taken consecutively from m_next
+    size_t m_next_hits;
+
+    // number of dequeues since this worker checked other LIFO slots
+    size_t m_passed_over_slots;
+
+    // number of dequeues that passed over jobs of each scheduling class
+    size_t m_passed_over[num_priorities];
+
+    // set by the worker thread once it is about to return
+    std::atomic<bool> m_stopped;
+
+    // counters are written by this worker only and padded
+    // to avoid false sharing with other workers
+    char m_pad1[CPPA_CACHE_LINE_SIZE];
+    std::atomic<std::uint64_t> m_jobs;
+    std::atomic<std::uint64_t> m_messages;
+    std::atomic<std::uint64_t> m_steals;
+    std::atomic<std::int64_t> m_busy_ns;
+    std::atomic<std::int64_t> m_idle_ns;
+    char m_pad2[CPPA_CACHE_LINE_SIZE];
+
+    // increments a counter without an atomic read-modify-write operation
+    template<typename T>
+    static inline void count(std::atomic<T>& counter, T num) {
+        counter.store(counter.load(std::memory_order_relaxed) + num,
+                      std::memory_order_relaxed);
+    }
+
+    worker(thread_pool_scheduler* parent, size_t id, job_ptr dummy)
+    : m_parent(parent), m_id(id), m_dummy(dummy), m_node(0), m_cpu(-1)
+    , m_next(nullptr), m_next_hits(0), m_passed_over_slots(0)
+    , m_passed_over(), m_stopped(true)
+    , m_jobs(0), m_messages(0), m_steals(0), m_busy_ns(0), m_idle_ns(0) { }
+
+    worker(const worker&) = delete;
+
+    worker& operator=(const worker&) = delete;
+
+    void start();
+
+    inline bool retiring() const {
+        return m_id >= m_parent->m_active.load();
+    }
+
+    // returns false if this worker retires
+    bool dequeue(job_ptr& result);
+
+    // sets m_stopped unless resize() activated this worker again
+    // in the meantime, called before leaving the worker loop
+    bool confirm_retirement();
+
+    // moves the job from the LIFO slot to result unless the worker
+    // already exceeded the limit of consecutive slot hits
+    bool take_next(job_ptr& result);
+
+    bool aggressive(job_ptr& result);
+
+    bool moderate(job_ptr& result);
+
+    bool relaxed(job_ptr& result);
+
+    // blocks until a job becomes available or this worker retires
+    bool park(job_ptr& result);
+
+    void operator()();
 
 };
 
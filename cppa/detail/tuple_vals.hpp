@@ -31,13 +31,16 @@
 #ifndef CPPA_TUPLE_VALS_HPP
 #define CPPA_TUPLE_VALS_HPP
 
+#include <cstdint>
 #include <stdexcept>
 
 #include "cppa/util/type_list.hpp"
 
 #include "cppa/detail/tdata.hpp"
+#include "cppa/detail/memory.hpp"
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/abstract_tuple.hpp"
+#include "cppa/detail/embedded_tuple.hpp"
 #include "cppa/detail/serialize_tuple.hpp"
 
 namespace cppa { namespace detail {
@@ -58,9 +61,21 @@ class tuple_vals : public abstract_tuple {
 
     tuple_vals(const tuple_vals&) = default;
 
+    tuple_vals(tuple_vals&& other)
+    : super(other), m_data(std::move(other.m_data)) { }
+
     template<typename... Us>
     tuple_vals(Us&&... args) : super(false), m_data(std::forward<Us>(args)...) { }
 
+    // instances are allocated from the size-class slabs of the calling thread
+    static void* operator new(size_t size) {
+        return memory::allocate(size);
+    }
+
+    static void operator delete(void* ptr, size_t size) {
+        memory::deallocate(ptr, size);
+    }
+
     const void* native_data() const {
         return &m_data;
     }
@@ -85,6 +100,16 @@ class tuple_vals : public abstract_tuple {
         return new tuple_vals(*this);
     }
 
+    abstract_tuple* move_to(void* storage, size_t size, embedding* owner) {
+        typedef embedded_tuple<tuple_vals> embedded_type;
+        auto addr = reinterpret_cast<std::uintptr_t>(storage);
+        if (   sizeof(embedded_type) > size
+            || addr % alignof(embedded_type) != 0) {
+            return nullptr;
+        }
+        return ::new (storage) embedded_type(owner, std::move(*this));
+    }
+
     const void* at(size_t pos) const {
         CPPA_REQUIRE(pos < size());
         return m_data.at(pos);
@@ -0,0 +1,130 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_WORK_STEALING_SCHEDULER_HPP
+#define CPPA_WORK_STEALING_SCHEDULER_HPP
+
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "cppa/util/shared_spinlock.hpp"
+
+#include "cppa/detail/thread_pool_scheduler.hpp"
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief A thread pool scheduler using one job queue per worker.
+ *
+ * Actors that become ready while a worker is running are enqueued to
+ * the local queue of that worker unless they run from its LIFO slot.
+ * Workers that run out of jobs take jobs from the shared queue (used by
+ * non-worker threads) and steal jobs from other workers afterwards.
+ * Local queues only hold actors of the normal {@link scheduling_priority},
+ * actors of the high class run before local jobs and actors of the low
+ * class after all shared jobs. Thieves prefer victims on their own NUMA
+ * node if workers are pinned (see {@link pin_workers()}).
+ */
+class work_stealing_scheduler : public thread_pool_scheduler {
+
+    typedef thread_pool_scheduler super;
+
+ public:
+
+    work_stealing_scheduler();
+
+    work_stealing_scheduler(size_t num_worker_threads);
+
+    void initialize();
+
+ protected:
+
+    scheduled_actor* try_dequeue(worker* w);
+
+    void enqueue_tail(worker* w, scheduled_actor* what);
+
+    void enqueue_tail(worker* w, const std::vector<scheduled_actor*>& what);
+
+    size_t queued_jobs() const;
+
+    void worker_retired(worker* w);
+
+ private:
+
+    // a double-ended queue owned by a single worker; the owner pushes to
+    // the back and pops from the front, thieves pop from the back
+    class local_queue {
+
+     public:
+
+        local_queue();
+
+        // returns the number of jobs in this queue after adding what
+        size_t push_back(scheduled_actor* what);
+
+        // returns the number of jobs in this queue after adding all jobs
+        size_t push_back(const std::vector<scheduled_actor*>& what);
+
+        scheduled_actor* pop_front();
+
+        scheduled_actor* pop_back();
+
+        // might return an outdated value
+        inline bool empty() const {
+            return m_size.load() == 0;
+        }
+
+        // might return an outdated value
+        inline size_t size() const {
+            return m_size.load(std::memory_order_relaxed);
+        }
+
+     private:
+
+        util::shared_spinlock m_lock;
+        std::atomic<size_t> m_size;
+        std::deque<scheduled_actor*> m_data;
+        // avoid false sharing between local queues
+        char m_pad[CPPA_CACHE_LINE_SIZE];
+
+    };
+
+    scheduled_actor* steal(worker* thief);
+
+    std::vector<std::unique_ptr<local_queue> > m_local_queues;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_WORK_STEALING_SCHEDULER_HPP
@@ -33,6 +33,7 @@
 
 #include <tuple>
 #include <stack>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -57,7 +58,7 @@ class event_based_actor : public extend<scheduled_actor>::with<stackless> {
 
  public:
 
-    resume_result resume(util::fiber*, actor_ptr&);
+    resume_result resume(util::fiber*);
 
     /**
      * @brief Initializes the actor.
@@ -68,10 +69,37 @@ class event_based_actor : public extend<scheduled_actor>::with<stackless> {
 
     static intrusive_ptr<event_based_actor> from(std::function<void()> fun);
 
+    /**
+     * @brief Causes this actor to give up its worker after handling the
+     *        current message until {@link end_suspension()} is called.
+     * @note Must be called from the thread running this actor.
+     */
+    void begin_suspension();
+
+    /**
+     * @brief Reschedules this actor if it gave up its worker
+     *        because of {@link begin_suspension()}.
+     */
+    void end_suspension();
+
+    mailbox_element* dequeue_batch_element(bool (*pred)(const any_tuple&)) override;
+
  protected:
 
     event_based_actor(actor_state st = actor_state::blocked);
 
+ private:
+
+    // returns true if this actor has to give up its worker
+    bool suspend();
+
+    std::atomic<int> m_suspension;
+
+    // number of messages on_batch may still append to the current
+    // message and number of messages it did append so far
+    size_t m_batch_limit;
+    size_t m_batched;
+
 };
 
 } // namespace cppa
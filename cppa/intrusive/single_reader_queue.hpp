@@ -31,9 +31,11 @@
 #ifndef CPPA_SINGLE_READER_QUEUE_HPP
 #define CPPA_SINGLE_READER_QUEUE_HPP
 
+#include <new>
 #include <list>
 #include <atomic>
 #include <memory>
+#include <cstddef>
 
 #include "cppa/config.hpp"
 
@@ -61,6 +63,15 @@ class single_reader_queue {
         return take_head();
     }
 
+    /**
+     * @brief Returns the element {@link try_pop()} would
+     *        return next without removing it.
+     * @warning call only from the reader (owner)
+     */
+    pointer peek() {
+        return (m_head != nullptr || fetch_new_data()) ? m_head : nullptr;
+    }
+
     template<class UnaryPredicate>
     void remove_if(UnaryPredicate f) {
         pointer head = m_head;
@@ -72,6 +83,7 @@ class single_reader_queue {
                     if (last == nullptr) m_head = p->next;
                     else last = p->next;
                     m_delete(p);
+                    count_dequeued(1);
                     return true;
                 }
                 else {
@@ -102,28 +114,112 @@ class single_reader_queue {
 
     // returns true if the queue was empty
     enqueue_result enqueue(pointer new_element) {
-        pointer e = m_stack.load();
-        for (;;) {
-            if (e == nullptr) {
-                m_delete(new_element);
-                return queue_closed; // queue is closed
-            }
-            new_element->next = e;
-            if (m_stack.compare_exchange_weak(e, new_element)) {
-                return (e == stack_end()) ? first_enqueued : enqueued;
-            }
+        return push(m_stack, m_enqueued, new_element);
+    }
+
+    /**
+     * @brief Enqueues @p new_element to the stack selected by @p hint
+     *        if this queue is sharded.
+     *
+     * Elements enqueued with the same @p hint are dequeued in the
+     * order they were enqueued. Returns @p first_enqueued whenever
+     * the selected stack was empty, i.e., a result of @p first_enqueued
+     * does not imply that the queue was empty if it is sharded.
+     */
+    enqueue_result enqueue(pointer new_element, size_t hint) {
+        auto i = hint & m_shards_mask;
+        if (i == 0) return push(m_stack, m_enqueued, new_element);
+        auto& s = m_shards[i - 1];
+        return push(s.stack, s.enqueued, new_element);
+    }
+
+    /**
+     * @brief Spreads concurrent writers across @p num_stacks stacks
+     *        (rounded up to a power of two) to reduce contention.
+     * @warning Call at most once and only before the queue is visible
+     *          to any other thread, i.e., before the first element was
+     *          enqueued and before passing it to the actor registry.
+     */
+    void shards(size_t num_stacks) {
+        CPPA_REQUIRE(m_shards == nullptr && m_stack.load() == stack_end());
+        size_t n = 1;
+        while (n < num_stacks) n <<= 1;
+        if (n == 1) return;
+        // new[] does not guarantee the alignment of shard, i.e., allocate
+        // one extra cache line and align the array manually
+        size_t bytes = (n - 1) * sizeof(shard);
+        size_t space = bytes + CPPA_CACHE_LINE_SIZE;
+        m_shards_storage.reset(new char[space]);
+        void* ptr = m_shards_storage.get();
+        ptr = std::align(CPPA_CACHE_LINE_SIZE, bytes, ptr, space);
+        CPPA_REQUIRE(ptr != nullptr);
+        m_shards = reinterpret_cast<shard*>(ptr);
+        for (size_t i = 0; i < n - 1; ++i) {
+            new (&m_shards[i]) shard;
+            m_shards[i].stack = stack_end();
+            m_shards[i].enqueued = 0;
+        }
+        m_shards_mask = n - 1;
+    }
+
+    inline size_t shards() const {
+        return m_shards_mask + 1;
+    }
+
+    /**
+     * @brief Returns the number of elements in this queue.
+     * @note Can be called from any thread. The result is approximated
+     *       if other threads are accessing the queue concurrently.
+     */
+    inline size_t size() const {
+        // load the consumer counter first, because m_enqueued
+        // is always greater or equal than m_dequeued
+        auto dequeued = m_dequeued.load(std::memory_order_relaxed);
+        return total_enqueued() - dequeued;
+    }
+
+    /**
+     * @brief Returns the number of elements enqueued so far.
+     * @note Can be called from any thread.
+     */
+    inline size_t total_enqueued() const {
+        auto result = m_enqueued.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < m_shards_mask; ++i) {
+            result += m_shards[i].enqueued.load(std::memory_order_relaxed);
         }
+        return result;
+    }
+
+    /**
+     * @brief Returns the number of elements dequeued so far.
+     * @note Can be called from any thread.
+     */
+    inline size_t total_dequeued() const {
+        return m_dequeued.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the largest size of this queue observed
+     *        by the reader whenever it fetched new elements.
+     * @note Can be called from any thread.
+     */
+    inline size_t high_water_mark() const {
+        return m_high_water_mark.load(std::memory_order_relaxed);
     }
 
     inline bool can_fetch_more() const {
-        return m_stack.load() != stack_end();
+        if (m_stack.load() != stack_end()) return true;
+        for (size_t i = 0; i < m_shards_mask; ++i) {
+            if (m_shards[i].stack.load() != stack_end()) return true;
+        }
+        return false;
     }
 
     /**
      * @warning call only from the reader (owner)
      */
     inline bool empty() const {
-        return closed() || (m_head == nullptr && m_stack.load() == stack_end());
+        return closed() || (m_head == nullptr && !can_fetch_more());
     }
 
     inline bool closed() const {
@@ -146,7 +242,9 @@ class single_reader_queue {
         if (fetch_new_data(nullptr)) clear_cached_elements(f);
     }
 
-    inline single_reader_queue() : m_head(nullptr) {
+    inline single_reader_queue()
+    : m_enqueued(0), m_shards(nullptr), m_shards_mask(0), m_head(nullptr)
+    , m_dequeued(0), m_high_water_mark(0) {
         m_stack = stack_end();
     }
 
@@ -163,22 +261,61 @@ class single_reader_queue {
 
     // exposed to "outside" access
     std::atomic<pointer> m_stack;
+    std::atomic<size_t> m_enqueued;
+
+    // additional stacks of a sharded queue, each using its own cache line
+    struct shard {
+        std::atomic<pointer> stack;
+        std::atomic<size_t> enqueued;
+        char pad[CPPA_CACHE_LINE_SIZE - sizeof(stack) - sizeof(enqueued)];
+    };
+
+    static_assert(sizeof(shard) == CPPA_CACHE_LINE_SIZE,
+                  "sizeof(shard) != CPPA_CACHE_LINE_SIZE");
+
+    // shards are trivially destructible, i.e., releasing the
+    // storage is sufficient; m_shards points into m_shards_storage
+    std::unique_ptr<char[]> m_shards_storage;
+    shard* m_shards;
+    size_t m_shards_mask;
 
     // accessed only by the owner
     pointer m_head;
     Delete  m_delete;
 
-    // atomically sets m_stack back and enqueues all elements to the cache
-    bool fetch_new_data(pointer end_ptr) {
-        CPPA_REQUIRE(m_head == nullptr);
-        CPPA_REQUIRE(end_ptr == nullptr || end_ptr == stack_end());
-        pointer e = m_stack.load();
-        // it's enough to check this once, since only the owner is allowed
-        // to close the queue and only the owner is allowed to call this
-        // member function
-        if (e == nullptr) return false;
+    // written only by the owner
+    std::atomic<size_t> m_dequeued;
+    std::atomic<size_t> m_high_water_mark;
+
+    inline void count_dequeued(size_t num) {
+        m_dequeued.store(m_dequeued.load(std::memory_order_relaxed) + num,
+                         std::memory_order_relaxed);
+    }
+
+    enqueue_result push(std::atomic<pointer>& stack,
+                        std::atomic<size_t>& counter,
+                        pointer new_element) {
+        // count before pushing to make sure size() never underflows
+        counter.fetch_add(1, std::memory_order_relaxed);
+        pointer e = stack.load();
+        for (;;) {
+            if (e == nullptr) {
+                counter.fetch_sub(1, std::memory_order_relaxed);
+                m_delete(new_element);
+                return queue_closed; // queue is closed
+            }
+            new_element->next = e;
+            if (stack.compare_exchange_weak(e, new_element)) {
+                return (e == stack_end()) ? first_enqueued : enqueued;
+            }
+        }
+    }
+
+    // atomically sets stack back and prepends all elements to the cache
+    bool fetch_from(std::atomic<pointer>& stack, pointer end_ptr) {
+        pointer e = stack.load();
         while (e != end_ptr) {
-            if (m_stack.compare_exchange_weak(e, end_ptr)) {
+            if (stack.compare_exchange_weak(e, end_ptr)) {
                 while (e != stack_end()) {
                     auto next = e->next;
                     e->next = m_head;
@@ -192,6 +329,32 @@ class single_reader_queue {
         return false;
     }
 
+    // atomically sets all stacks back and enqueues all elements to the cache
+    bool fetch_new_data(pointer end_ptr) {
+        CPPA_REQUIRE(m_head == nullptr);
+        CPPA_REQUIRE(end_ptr == nullptr || end_ptr == stack_end());
+        // it's enough to check this once, since only the owner is allowed
+        // to close the queue and only the owner is allowed to call this
+        // member function; m_stack is closed last
+        if (m_stack.load() == nullptr) return false;
+        bool result = false;
+        // each stack is prepended as a whole, which keeps
+        // the order of elements enqueued to the same stack
+        for (size_t i = 0; i < m_shards_mask; ++i) {
+            if (fetch_from(m_shards[i].stack, end_ptr)) result = true;
+        }
+        if (fetch_from(m_stack, end_ptr)) result = true;
+        if (result) {
+            // sample the size once per fetch rather than
+            // per element to keep enqueue/dequeue cheap
+            auto n = size();
+            if (n > m_high_water_mark.load(std::memory_order_relaxed)) {
+                m_high_water_mark.store(n, std::memory_order_relaxed);
+            }
+        }
+        return result;
+    }
+
     inline bool fetch_new_data() {
         return fetch_new_data(stack_end());
     }
@@ -200,6 +363,7 @@ class single_reader_queue {
         if (m_head != nullptr || fetch_new_data()) {
             auto result = m_head;
             m_head = m_head->next;
+            count_dequeued(1);
             return result;
         }
         return nullptr;
@@ -0,0 +1,144 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_SINGLY_LINKED_LIST_HPP
+#define CPPA_SINGLY_LINKED_LIST_HPP
+
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+namespace cppa { namespace intrusive {
+
+/**
+ * @brief An intrusive, non thread safe singly linked list
+ *        with O(1) insertion at its back.
+ *
+ * Elements are linked via their member <tt>next</tt>. The list
+ * owns all of its elements and deletes them using @p Delete.
+ */
+template<typename T, class Delete = std::default_delete<T> >
+class singly_linked_list {
+
+    singly_linked_list(const singly_linked_list&) = delete;
+    singly_linked_list& operator=(const singly_linked_list&) = delete;
+
+ public:
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+
+    singly_linked_list() : m_head(nullptr), m_tail(nullptr) { }
+
+    singly_linked_list(singly_linked_list&& other)
+    : m_head(other.m_head), m_tail(other.m_tail) {
+        other.m_head = other.m_tail = nullptr;
+    }
+
+    singly_linked_list& operator=(singly_linked_list&& other) {
+        clear();
+        std::swap(m_head, other.m_head);
+        std::swap(m_tail, other.m_tail);
+        return *this;
+    }
+
+    ~singly_linked_list() { clear(); }
+
+    inline bool empty() const { return m_head == nullptr; }
+
+    inline pointer front() const { return m_head; }
+
+    inline pointer back() const { return m_tail; }
+
+    void push_back(pointer ptr) {
+        ptr->next = nullptr;
+        if (m_tail) m_tail->next = ptr;
+        else m_head = ptr;
+        m_tail = ptr;
+    }
+
+    /**
+     * @brief Unlinks the successor of @p pred or the first element
+     *        if @p pred is @p nullptr and passes ownership to the caller.
+     */
+    pointer take_after(pointer pred) {
+        pointer result = pred ? pred->next : m_head;
+        if (result) {
+            if (pred) pred->next = result->next;
+            else m_head = result->next;
+            if (result == m_tail) m_tail = pred;
+            result->next = nullptr;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Deletes the successor of @p pred or the first element
+     *        if @p pred is @p nullptr.
+     * @returns The element following the deleted element.
+     */
+    pointer erase_after(pointer pred) {
+        pointer ptr = take_after(pred);
+        pointer result = pred ? pred->next : m_head;
+        if (ptr) m_delete(ptr);
+        return result;
+    }
+
+    /**
+     * @brief Deletes @p ptr, which is required to be an element of this list.
+     * @note This member function has linear complexity, use
+     *       {@link erase_after()} whenever the predecessor is known.
+     */
+    void erase(pointer ptr) {
+        pointer pred = nullptr;
+        for (pointer i = m_head; i != ptr; i = i->next) pred = i;
+        erase_after(pred);
+    }
+
+    void clear() {
+        while (m_head) {
+            pointer next = m_head->next;
+            m_delete(m_head);
+            m_head = next;
+        }
+        m_tail = nullptr;
+    }
+
+ private:
+
+    pointer m_head;
+    pointer m_tail;
+    Delete m_delete;
+
+};
+
+} } // namespace cppa::intrusive
+
+#endif // CPPA_SINGLY_LINKED_LIST_HPP
@@ -31,7 +31,13 @@
 #ifndef CPPA_IO_BUFFERED_WRITING_HPP
 #define CPPA_IO_BUFFERED_WRITING_HPP
 
+#include <deque>
+#include <chrono>
+#include <vector>
 #include <utility>
+#include <algorithm>
+
+#include <sys/uio.h>
 
 #include "cppa/util/buffer.hpp"
 
@@ -41,6 +47,14 @@
 
 namespace cppa { namespace io {
 
+/**
+ * @brief Buffers outgoing data in a chain of chunks that is written with
+ *        a single vectored write per call to {@link continue_writing()}.
+ *
+ * Small writes are appended to the last chunk. A chunk that is partially
+ * written or that reached @p max_chunk_size is never appended to, i.e.,
+ * fully written chunks are released without moving the remaining bytes.
+ */
 template<class Base, class Subtype>
 class buffered_writing : public Base {
 
@@ -51,27 +65,51 @@ class buffered_writing : public Base {
     template<typename... Ts>
     buffered_writing(middleman* mm, output_stream_ptr out, Ts&&... args)
     : super{std::forward<Ts>(args)...}, m_middleman{mm}, m_out{out}
-    , m_has_unwritten_data{false} { }
+    , m_has_unwritten_data{false}, m_flush_pending{false}
+    , m_sealed{0}, m_offset{0} { }
+
+    ~buffered_writing() {
+        if (m_flush_pending) m_middleman->cancel_continue_writer_at(this);
+    }
 
     continue_writing_result continue_writing() override {
         CPPA_LOG_TRACE("");
+        // we get here either because of register_for_writing()
+        // or because the deadline set by flush_later() has passed
+        if (m_flush_pending) {
+            m_flush_pending = false;
+            m_middleman->cancel_continue_writer_at(this);
+        }
+        if (!m_chunks.empty()) m_has_unwritten_data = true;
         CPPA_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
         while (m_has_unwritten_data) {
+            iovec bufs[max_iov];
+            size_t num_bufs = 0;
+            size_t total = 0;
+            for (auto i = m_chunks.begin();
+                 i != m_chunks.end() && num_bufs < max_iov;
+                 ++i) {
+                auto offset = (num_bufs == 0) ? m_offset : 0;
+                bufs[num_bufs].iov_base = static_cast<char*>(i->data())
+                                        + offset;
+                bufs[num_bufs].iov_len = i->size() - offset;
+                total += bufs[num_bufs].iov_len;
+                ++num_bufs;
+            }
             size_t written;
-            try { written = m_out->write_some(m_buf.data(), m_buf.size()); }
+            try { written = m_out->write_some(bufs, num_bufs); }
             catch (std::exception& e) {
                 CPPA_LOG_ERROR(to_verbose_string(e));
                 static_cast<void>(e); // keep compiler happy
                 return write_failure;
             }
-            if (written != m_buf.size()) {
-                CPPA_LOG_DEBUG("tried to write " << m_buf.size() << "bytes, "
+            consume(written);
+            if (written != total) {
+                CPPA_LOG_DEBUG("tried to write " << total << "bytes, "
                                << "only " << written << " bytes written");
-                m_buf.erase_leading(written);
                 return write_continue_later;
             }
-            else {
-                m_buf.clear();
+            if (m_chunks.empty()) {
                 m_has_unwritten_data = false;
                 CPPA_LOG_DEBUG("write done, " << written << " bytes written");
             }
@@ -84,7 +122,7 @@ class buffered_writing : public Base {
     }
 
     void write(size_t num_bytes, const void* data) {
-        m_buf.write(num_bytes, data);
+        write_buffer().write(num_bytes, data);
         register_for_writing();
     }
 
@@ -92,16 +130,27 @@ class buffered_writing : public Base {
         write(buf.size(), buf.data());
     }
 
+    /**
+     * @brief Adds @p buf to the chain without copying its content
+     *        unless it is smaller than @p min_chunk_size.
+     */
     void write(util::buffer&& buf) {
-        if (m_buf.empty()) m_buf = std::move(buf);
-        else {
-            m_buf.write(buf.size(), buf.data());
+        if (buf.size() < min_chunk_size) {
+            write_buffer().write(buf.size(), buf.data());
             buf.clear();
         }
+        else {
+            m_chunks.push_back(std::move(buf));
+            m_sealed = m_chunks.size();
+        }
         register_for_writing();
     }
 
     void register_for_writing() {
+        if (m_flush_pending) {
+            m_flush_pending = false;
+            m_middleman->cancel_continue_writer_at(this);
+        }
         if (!m_has_unwritten_data) {
             CPPA_LOG_DEBUG("register for writing");
             m_has_unwritten_data = true;
@@ -109,8 +158,52 @@ class buffered_writing : public Base {
         }
     }
 
-    inline util::buffer& write_buffer() {
-        return m_buf;
+    /**
+     * @brief Registers for writing once {@link cppa::flush_delay()} has
+     *        passed or immediately if the unwritten data reached
+     *        {@link cppa::flush_threshold()}, i.e., coalesces
+     *        subsequent writes into a single vectored write.
+     */
+    void flush_later() {
+        if (m_has_unwritten_data) return; // already registered
+        auto delay = cppa::flush_delay();
+        if (delay.count() == 0 || unwritten_bytes() >= cppa::flush_threshold()) {
+            register_for_writing();
+        }
+        else if (!m_flush_pending) {
+            CPPA_LOG_DEBUG("register for writing in " << delay.count() << "us");
+            m_flush_pending = true;
+            m_middleman->continue_writer_at(this, std::chrono::steady_clock::now()
+                                                  + delay);
+        }
+    }
+
+    /**
+     * @brief Returns the number of bytes not yet written.
+     */
+    size_t unwritten_bytes() const {
+        size_t result = 0;
+        for (auto& chunk : m_chunks) result += chunk.size();
+        return result - m_offset;
+    }
+
+    /**
+     * @brief Returns the chunk for appending data. The returned reference
+     *        is invalidated by any other call to a member function
+     *        except {@link write_buffer()}.
+     */
+    util::buffer& write_buffer() {
+        if (   m_chunks.size() == m_sealed
+            || m_chunks.back().size() >= max_chunk_size) {
+            if (m_spare.empty()) m_chunks.emplace_back();
+            else {
+                m_chunks.push_back(std::move(m_spare.back()));
+                m_spare.pop_back();
+            }
+            // the first chunk is sealed once it gets written partially
+            m_sealed = m_chunks.size() - 1;
+        }
+        return m_chunks.back();
     }
 
  protected:
@@ -119,10 +212,58 @@ class buffered_writing : public Base {
 
  private:
 
+    // maximum number of chunks per vectored write
+    static constexpr size_t max_iov = 64;
+
+    // size at which write_buffer() starts a new chunk
+    static constexpr size_t max_chunk_size = 64 * 1024;
+
+    // smaller buffers are copied instead of added to the chain
+    static constexpr size_t min_chunk_size = 1024;
+
+    // maximum number of cleared chunks kept for reuse
+    static constexpr size_t max_spare_chunks = 4;
+
+    // removes the first num_bytes bytes from the chain
+    void consume(size_t num_bytes) {
+        while (!m_chunks.empty()) {
+            auto& front = m_chunks.front();
+            auto available = front.size() - m_offset;
+            if (num_bytes < available) {
+                if (num_bytes > 0) {
+                    // keep the remainder in place and never append to it
+                    m_offset += num_bytes;
+                    m_sealed = std::max<size_t>(m_sealed, 1);
+                }
+                return;
+            }
+            num_bytes -= available;
+            m_offset = 0;
+            front.clear();
+            if (m_spare.size() < max_spare_chunks) {
+                m_spare.push_back(std::move(front));
+            }
+            m_chunks.pop_front();
+            if (m_sealed > 0) --m_sealed;
+        }
+    }
+
     middleman* m_middleman;
     output_stream_ptr m_out;
     bool m_has_unwritten_data;
-    util::buffer m_buf;
+
+    // set if flush_later() scheduled a call to continue_writing()
+    bool m_flush_pending;
+
+    // chunks waiting to be written, the first m_sealed chunks are
+    // never appended to
+    std::deque<util::buffer> m_chunks;
+    size_t m_sealed;
+
+    // number of bytes of the first chunk that were already written
+    size_t m_offset;
+
+    std::vector<util::buffer> m_spare;
 
 };
 
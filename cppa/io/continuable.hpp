@@ -94,6 +94,11 @@ class continuable {
 
     /**
      * @brief Reads from {@link read_handle()} if valid.
+     * @note Implementations must read until the socket reports
+     *       @p EAGAIN or a read returns fewer bytes than requested
+     *       before returning @p read_continue_later, because an
+     *       edge-triggered event handler (see CPPA_EPOLL_EDGE_TRIGGERED)
+     *       does not report data that was already available again.
      */
     virtual continue_reading_result continue_reading();
 
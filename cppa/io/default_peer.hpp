@@ -99,6 +99,9 @@ class default_peer : public extend<continuable>::with<buffered_writing> {
     read_state m_state;
     process_information_ptr m_node;
 
+    // size of the message currently read (state read_message)
+    std::uint32_t m_msg_size;
+
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
 
@@ -142,6 +145,12 @@ class default_peer : public extend<continuable>::with<buffered_writing> {
 
     void add_type_if_needed(const std::string& tname);
 
+    // returns the number of bytes needed to complete the current frame
+    size_t frame_size() const;
+
+    // consumes a frame of frame_size() bytes; returns false on error
+    bool handle_frame(const char* frame);
+
 };
 
 } } // namespace cppa::network
@@ -56,6 +56,8 @@ class ipv4_io_stream : public stream {
 
     size_t write_some(const void* buf, size_t len);
 
+    size_t write_some(const iovec* bufs, size_t num_bufs);
+
  private:
 
     ipv4_io_stream(native_socket_type fd);
@@ -32,6 +32,7 @@
 #define MIDDLEMAN_HPP
 
 #include <map>
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -102,6 +103,21 @@ class middleman {
      */
     bool has_reader(continuable* ptr);
 
+    /**
+     * @brief Adds @p ptr to the list of active writers once
+     *        @p deadline is reached.
+     * @warning This member function is not thread-safe.
+     */
+    void continue_writer_at(continuable* ptr,
+                            std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * @brief Cancels all pending {@link continue_writer_at()}
+     *        calls for @p ptr.
+     * @warning This member function is not thread-safe.
+     */
+    void cancel_continue_writer_at(continuable* ptr);
+
  protected:
 
     // destroys singleton
@@ -128,4 +144,34 @@ class middleman {
 
 } } // namespace cppa::detail
 
+namespace cppa {
+
+/**
+ * @brief Sets how long outgoing messages to other nodes may be held back
+ *        in order to send them with a single write. A delay of zero,
+ *        the default, sends each message immediately.
+ * @note The middleman waits with millisecond precision, i.e., a delay
+ *       is rounded up to full milliseconds.
+ */
+void flush_delay(std::chrono::microseconds delay);
+
+/**
+ * @brief Retrieves the delay set via {@link flush_delay()}.
+ */
+std::chrono::microseconds flush_delay();
+
+/**
+ * @brief Sets the number of held back bytes per connection that
+ *        causes the middleman to write them regardless of the
+ *        {@link flush_delay()}. The default is 64 KB.
+ */
+void flush_threshold(size_t num_bytes);
+
+/**
+ * @brief Retrieves the threshold set via {@link flush_threshold()}.
+ */
+size_t flush_threshold();
+
+} // namespace cppa
+
 #endif // MIDDLEMAN_HPP
@@ -71,11 +71,12 @@ class middleman_event_handler {
     void erase_later(continuable* ptr, event_bitmask e);
 
     /**
-     * @brief Poll all events.
+     * @brief Poll all events, waiting at most @p timeout milliseconds
+     *        or indefinitely if @p timeout is negative.
      */
     template<typename F>
-    void poll(const F& fun) {
-        poll_impl();
+    void poll(int timeout, const F& fun) {
+        poll_impl(timeout);
         for (auto& p : m_events) fun(p.first, p.second);
         m_events.clear();
         update();
@@ -115,10 +116,13 @@ class middleman_event_handler {
 
     std::vector<continuable*> m_dispose_list;
 
+    // returns the entry for fd in m_meta or nullptr
+    const fd_meta_info* meta_of(native_socket_type fd) const;
+
     middleman_event_handler();
 
     // fills the event vector
-    virtual void poll_impl() = 0;
+    virtual void poll_impl(int timeout) = 0;
 
     virtual void handle_event(fd_meta_event me,
                               native_socket_type fd,
@@ -130,6 +134,17 @@ class middleman_event_handler {
 
     void alteration(continuable* ptr, event_bitmask e, fd_meta_event etype);
 
+    // net change of a file descriptor during update()
+    struct fd_change {
+        native_socket_type fd;
+        continuable* old_ptr;
+        event_bitmask old_mask;
+        continuable* ptr;
+        event_bitmask mask;
+    };
+
+    std::vector<fd_change> m_changes;
+
     event_bitmask next_bitmask(event_bitmask old, event_bitmask arg, fd_meta_event op) const;
 
 };
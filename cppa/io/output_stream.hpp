@@ -31,6 +31,8 @@
 #ifndef CPPA_OUTPUT_STREAM_HPP
 #define CPPA_OUTPUT_STREAM_HPP
 
+#include <sys/uio.h>
+
 #include "cppa/config.hpp"
 #include "cppa/ref_counted.hpp"
 #include "cppa/intrusive_ptr.hpp"
@@ -65,6 +67,23 @@ class output_stream : public virtual ref_counted {
      */
     virtual size_t write_some(const void* buf, size_t num_bytes) = 0;
 
+    /**
+     * @brief Tries to write the @p num_bufs buffers in @p bufs in order.
+     * @returns The number of written bytes.
+     * @throws std::ios_base::failure
+     * @note The default implementation calls {@link write_some()}
+     *       once per buffer until a write is incomplete.
+     */
+    virtual size_t write_some(const iovec* bufs, size_t num_bufs) {
+        size_t result = 0;
+        for (size_t i = 0; i < num_bufs; ++i) {
+            auto written = write_some(bufs[i].iov_base, bufs[i].iov_len);
+            result += written;
+            if (written < bufs[i].iov_len) return result;
+        }
+        return result;
+    }
+
 };
 
 /**
@@ -164,16 +164,6 @@ class local_actor : public extend<actor>::with<memory_cached> {
      */
     inline void trap_exit(bool new_value);
 
-    /**
-     * @brief Checks whether this actor uses the "chained send" optimization.
-     */
-    inline bool chaining() const;
-
-    /**
-     * @brief Enables or disables chained send.
-     */
-    inline void chaining(bool new_value);
-
     /**
      * @brief Returns the last message that was dequeued
      *        from the actor's mailbox.
@@ -271,6 +261,12 @@ class local_actor : public extend<actor>::with<memory_cached> {
 
     /** @cond PRIVATE */
 
+    // dequeues the next message if it is an asynchronous message
+    // for which pred returns true and if handling it right after the
+    // current message keeps the order of messages (used by on_batch);
+    // the default implementation always returns nullptr
+    virtual mailbox_element* dequeue_batch_element(bool (*pred)(const any_tuple&));
+
     inline message_id new_request_id() {
         auto result = ++m_last_request_id;
         m_pending_responses.push_back(result.response_id());
@@ -297,12 +293,10 @@ class local_actor : public extend<actor>::with<memory_cached> {
 
     inline void do_unbecome();
 
-    local_actor(bool is_scheduled = false);
+    local_actor();
 
     virtual bool initialized() const = 0;
 
-    inline bool chaining_enabled();
-
     message_id send_timed_sync_message(message_priority mp,
                                        const actor_ptr& whom,
                                        const util::duration& rel_time,
@@ -316,10 +310,6 @@ class local_actor : public extend<actor>::with<memory_cached> {
 
     void forward_message(const actor_ptr& new_receiver, message_priority prio);
 
-    inline const actor_ptr& chained_actor();
-
-    inline void chained_actor(const actor_ptr& value);
-
     inline bool awaits(message_id response_id);
 
     inline void mark_arrived(message_id response_id);
@@ -349,18 +339,9 @@ class local_actor : public extend<actor>::with<memory_cached> {
     // used *only* when compiled in debug mode
     union { std::string m_debug_name; };
 
-    // true if this actor uses the chained_send optimization
-    bool m_chaining;
-
     // true if this actor receives EXIT messages as ordinary messages
     bool m_trap_exit;
 
-    // true if this actor takes part in cooperative scheduling
-    bool m_is_scheduled;
-
-    // pointer to the actor that is marked as successor due to a chained send
-    actor_ptr m_chained_actor;
-
     // identifies the ID of the last sent synchronous request
     message_id m_last_request_id;
 
@@ -423,15 +404,9 @@ inline void local_actor::trap_exit(bool new_value) {
     m_trap_exit = new_value;
 }
 
-inline bool local_actor::chaining() const {
-    return m_chaining;
-}
-
-inline void local_actor::chaining(bool new_value) {
-    m_chaining = m_is_scheduled && new_value;
-}
-
 inline any_tuple& local_actor::last_dequeued() {
+    // the caller might share the message with other actors
+    m_current_node->move_msg_to_heap();
     return m_current_node->msg;
 }
 
@@ -443,23 +418,11 @@ inline void local_actor::do_unbecome() {
     m_bhvr_stack.pop_async_back();
 }
 
-inline bool local_actor::chaining_enabled() {
-    return m_chaining && !m_chained_actor;
-}
-
 inline message_id local_actor::get_response_id() {
     auto id = m_current_node->mid;
     return (id.is_request()) ? id.response_id() : message_id();
 }
 
-inline const actor_ptr& local_actor::chained_actor() {
-    return m_chained_actor;
-}
-
-inline void local_actor::chained_actor(const actor_ptr& value) {
-    m_chained_actor = value;
-}
-
 inline bool local_actor::awaits(message_id response_id) {
     CPPA_REQUIRE(response_id.is_response());
     return std::any_of(m_pending_responses.begin(),
@@ -31,9 +31,22 @@
 #ifndef CPPA_MAILBOX_BASED_HPP
 #define CPPA_MAILBOX_BASED_HPP
 
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
 #include <type_traits>
 
+#include "cppa/singletons.hpp"
+#include "cppa/spawn_options.hpp"
+#include "cppa/mailbox_stats.hpp"
 #include "cppa/mailbox_element.hpp"
+#include "cppa/mailbox_overflow.hpp"
+#include "cppa/util/shared_spinlock.hpp"
+#include "cppa/detail/backpressure.hpp"
+#include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/sync_request_bouncer.hpp"
 #include "cppa/intrusive/single_reader_queue.hpp"
 
@@ -50,6 +63,54 @@ class mailbox_based : public Base {
         if (!m_mailbox.closed()) {
             detail::sync_request_bouncer f{this->exit_reason()};
             m_mailbox.close(f);
+            unregister_mailbox();
+        }
+    }
+
+    size_t mailbox_size() const override {
+        return m_mailbox.size();
+    }
+
+    /**
+     * @brief Returns the counters of this actor's mailbox.
+     */
+    mailbox_stats mailbox_statistics() const {
+        auto dequeued = m_mailbox.total_dequeued();
+        auto enqueued = m_mailbox.total_enqueued();
+        return {this->id(), enqueued - dequeued,
+                m_mailbox.high_water_mark(), enqueued, dequeued};
+    }
+
+    /**
+     * @brief Limits the mailbox to @p capacity messages; 0 means unbounded.
+     * @param policy Selects how messages arriving at a full mailbox
+     *               are handled.
+     * @note Must be called before this actor receives its first message.
+     */
+    inline void mailbox_capacity(size_t capacity, mailbox_overflow policy) {
+        m_mailbox_capacity = capacity;
+        m_mailbox_overflow = policy;
+    }
+
+    inline size_t mailbox_capacity() const {
+        return m_mailbox_capacity;
+    }
+
+    /**
+     * @brief Applies the mailbox settings in @p opts, i.e.,
+     *        {@link bounded_mailbox()} and {@link sharded_mailbox}.
+     * @note Must be called before this actor receives its first message.
+     *       The mailbox is not visible to the actor registry until then
+     *       (see {@link enqueue_message()}), i.e., setting up its stacks
+     *       cannot race with {@link detail::actor_registry::largest_mailboxes()}.
+     */
+    void configure_mailbox(spawn_options opts) {
+        mailbox_capacity(get_mailbox_capacity(opts),
+                         get_mailbox_overflow(opts));
+        if (has_sharded_mailbox_flag(opts)) {
+            // more stacks than threads cannot reduce contention any further
+            auto n = std::max(std::thread::hardware_concurrency(), 2u);
+            m_mailbox.shards(std::min(n, 64u));
         }
     }
 
@@ -60,21 +121,196 @@ class mailbox_based : public Base {
     typedef intrusive::single_reader_queue<mailbox_element, del> mailbox_type;
 
     template<typename... Ts>
-    mailbox_based(Ts&&... args) : Base(std::forward<Ts>(args)...) { }
+    mailbox_based(Ts&&... args)
+    : Base(std::forward<Ts>(args)...), m_mailbox_capacity(0)
+    , m_mailbox_overflow(mailbox_overflow::drop_newest)
+    , m_has_suspended_senders(false), m_registered(false) { }
 
     void cleanup(std::uint32_t reason) override {
         detail::sync_request_bouncer f{reason};
         m_mailbox.close(f);
+        unregister_mailbox();
+        if (m_has_suspended_senders) resume_suspended_senders();
         Base::cleanup(reason);
     }
 
+    /**
+     * @brief Checks whether a message with header @p hdr can be enqueued
+     *        to the mailbox; returns @p false if the message is discarded.
+     */
+    inline bool admit_message(const message_header& hdr) {
+        if (   m_mailbox_capacity == 0
+            || m_mailbox.size() < m_mailbox_capacity) {
+            return true;
+        }
+        return admit_overflow(hdr);
+    }
+
+    /**
+     * @brief Dequeues the next message from the mailbox and
+     *        enforces the mailbox capacity.
+     * @warning Call only from the thread running this actor.
+     */
+    inline mailbox_element* dequeue_message() {
+        if (m_mailbox_capacity == 0) return m_mailbox.try_pop();
+        return dequeue_bounded();
+    }
+
+    /**
+     * @brief Dequeues the next message if @p pred returns @p true
+     *        for it, otherwise the message remains in the mailbox.
+     * @warning Call only from the thread running this actor.
+     */
+    template<class Predicate>
+    mailbox_element* dequeue_message_if(Predicate pred) {
+        if (m_mailbox_capacity > 0) drop_overflow();
+        auto e = m_mailbox.peek();
+        if (e == nullptr || !pred(*e)) return nullptr;
+        // we are the only reader, i.e., the head cannot change
+        static_cast<void>(m_mailbox.try_pop());
+        if (m_mailbox_capacity > 0) resume_after_dequeue();
+        return e;
+    }
+
     template<typename... Ts>
     inline mailbox_element* new_mailbox_element(Ts&&... args) {
         return mailbox_element::create(std::forward<Ts>(args)...);
     }
 
+    /**
+     * @brief Enqueues @p ptr to @p mbox. A sharded mailbox enqueues
+     *        all messages of a sender to the same stack to keep them
+     *        in order.
+     *
+     * The mailbox becomes visible to {@link detail::actor_registry::largest_mailboxes()}
+     * once a message arrives at a non-empty mailbox, i.e., spawning
+     * an actor does not touch the registry and only actors that ever
+     * have a backlog are registered.
+     */
+    inline intrusive::enqueue_result
+    enqueue_message(mailbox_type& mbox, mailbox_element* ptr) {
+        auto& sender = ptr->sender;
+        auto result = mbox.enqueue(ptr, sender ? sender->id() : 0);
+        if (   result == intrusive::enqueued
+            && !m_registered.load(std::memory_order_relaxed)
+            && &mbox == &m_mailbox) {
+            register_mailbox();
+        }
+        return result;
+    }
+
     mailbox_type m_mailbox;
 
+ private:
+
+    void register_mailbox() {
+        // seq_cst pairs with unregister_mailbox(): either the owner sees
+        // the flag or add_mailbox() sees the closed mailbox
+        m_registered = true;
+        get_actor_registry()->add_mailbox(this->id(), &m_mailbox);
+    }
+
+    // must be called after closing the mailbox
+    void unregister_mailbox() {
+        if (m_registered) get_actor_registry()->remove_mailbox(this->id());
+    }
+
+    // senders cannot drop the oldest message or stop a suspended sender
+    // before its current message is done, i.e., the mailbox holds up to
+    // twice its capacity under drop_oldest and suspend_sender
+    inline size_t hard_limit() const {
+        return 2 * m_mailbox_capacity;
+    }
+
+    bool admit_overflow(const message_header& hdr) {
+        switch (m_mailbox_overflow) {
+            case mailbox_overflow::drop_oldest:
+                // the receiver drops messages in dequeue_bounded(),
+                // but a stalled receiver must not grow without limit
+                if (m_mailbox.size() < hard_limit()) return true;
+                detail::notify_overflow(this, hdr.sender, hdr.id);
+                return false;
+            case mailbox_overflow::reject:
+                detail::notify_overflow(this, hdr.sender, hdr.id);
+                return false;
+            case mailbox_overflow::suspend_sender: {
+                // a suspended sender is not registered if its message
+                // is rejected, because no dequeue would resume it
+                auto sender = m_mailbox.size() < hard_limit()
+                            ? detail::suspend_sender(hdr.sender)
+                            : actor_ptr{};
+                if (!sender) {
+                    detail::notify_overflow(this, hdr.sender, hdr.id);
+                    return false;
+                }
+                // the sender is registered before its message is
+                // enqueued, i.e., dequeueing that message is
+                // guaranteed to see the sender
+                std::lock_guard<util::shared_spinlock> guard{m_suspended_mtx};
+                if (   m_suspended_senders.empty()
+                    || m_suspended_senders.back() != sender) {
+                    m_suspended_senders.push_back(std::move(sender));
+                }
+                m_has_suspended_senders = true;
+                return true;
+            }
+            default:
+                // senders of synchronous requests would wait forever
+                if (hdr.id.is_request()) {
+                    detail::notify_overflow(this, hdr.sender, hdr.id);
+                }
+                return false;
+        }
+    }
+
+    mailbox_element* dequeue_bounded() {
+        drop_overflow();
+        auto result = m_mailbox.try_pop();
+        resume_after_dequeue();
+        return result;
+    }
+
+    void drop_overflow() {
+        if (m_mailbox_overflow == mailbox_overflow::drop_oldest) {
+            while (m_mailbox.size() > m_mailbox_capacity) {
+                auto e = m_mailbox.try_pop();
+                if (e == nullptr) break;
+                if (e->mid.is_request()) {
+                    detail::notify_overflow(this, e->sender, e->mid);
+                }
+                del{}(e);
+            }
+        }
+    }
+
+    void resume_after_dequeue() {
+        if (   m_has_suspended_senders.load()
+            && m_mailbox.size() < m_mailbox_capacity) {
+            resume_suspended_senders();
+        }
+    }
+
+    void resume_suspended_senders() {
+        std::vector<actor_ptr> senders;
+        { // lifetime scope of guard
+            std::lock_guard<util::shared_spinlock> guard{m_suspended_mtx};
+            senders.swap(m_suspended_senders);
+            m_has_suspended_senders = false;
+        }
+        detail::resume_senders(senders);
+    }
+
+    size_t m_mailbox_capacity;
+    mailbox_overflow m_mailbox_overflow;
+
+    // senders suspended by the suspend_sender policy
+    util::shared_spinlock m_suspended_mtx;
+    std::vector<actor_ptr> m_suspended_senders;
+    std::atomic<bool> m_has_suspended_senders;
+
+    // set once the mailbox was passed to actor_registry::add_mailbox
+    std::atomic<bool> m_registered;
+
 };
 
 } // namespace cppa
@@ -31,7 +31,9 @@
 #ifndef CPPA_RECURSIVE_QUEUE_NODE_HPP
 #define CPPA_RECURSIVE_QUEUE_NODE_HPP
 
+#include <atomic>
 #include <cstdint>
+#include <type_traits>
 
 #include "cppa/actor.hpp"
 #include "cppa/extend.hpp"
@@ -41,16 +43,31 @@
 #include "cppa/memory_cached.hpp"
 #include "cppa/message_header.hpp"
 
+#include "cppa/detail/tuple_vals.hpp"
+#include "cppa/detail/embedded_tuple.hpp"
+#include "cppa/detail/implicit_conversions.hpp"
+
+/**
+ * @brief Maximum size in bytes of a message stored inside its mailbox
+ *        element instead of a separate heap object, 0 disables inlining.
+ */
+#ifndef CPPA_INLINE_MESSAGE_SIZE
+#define CPPA_INLINE_MESSAGE_SIZE 64
+#endif
+
 // needs access to constructor + destructor to initialize m_dummy_node
 namespace cppa {
 
 class local_actor;
 
-class mailbox_element : public extend<memory_managed>::with<memory_cached> {
+class mailbox_element : public extend<memory_managed>::with<memory_cached>
+                      , public detail::embedding {
 
     friend class local_actor;
     friend class detail::memory;
 
+    typedef combined_type super;
+
  public:
 
     typedef mailbox_element* pointer;
@@ -66,19 +83,87 @@ class mailbox_element : public extend<memory_managed>::with<memory_cached> {
     mailbox_element& operator=(mailbox_element&&) = delete;
     mailbox_element& operator=(const mailbox_element&) = delete;
 
-    template<typename T>
-    inline static mailbox_element* create(const message_header& hdr, T&& data) {
-        return detail::memory::create<mailbox_element>(hdr, std::forward<T>(data));
-    }
+    /**
+     * @brief Creates a new element for @p data or takes over the element
+     *        storing @p data if it was created by {@link make_embedded()}.
+     */
+    static mailbox_element* create(const message_header& hdr, any_tuple data);
+
+    /**
+     * @brief Constructs <tt>{args...}</tt> in the inline storage of a new
+     *        mailbox element if it fits, otherwise on the heap.
+     *
+     * {@link create()} takes over the element instead of allocating
+     * another one, i.e., sending a small message to a local actor needs
+     * a single allocation. The element keeps the message alive if it is
+     * never enqueued to a mailbox, e.g., if it is sent to a remote actor.
+     */
+    template<typename... Ts>
+    static any_tuple make_embedded(Ts&&... args);
+
+    /**
+     * @brief Copies an embedded @p msg to the heap, because other actors
+     *        sharing an embedded message would keep this element alive.
+     * @note Called before @p msg is forwarded or handed out via
+     *       {@link local_actor::last_dequeued()}.
+     */
+    void move_msg_to_heap();
 
  private:
 
-    mailbox_element() = default;
+    mailbox_element();
 
     mailbox_element(const message_header& hdr, any_tuple data);
 
+    void request_deletion() override;
+
+    void release_embedded() override;
+
+    mailbox_element* claim_element() override;
+
+    void release_part();
+
+    bool embeds(const void* ptr) const;
+
+    static constexpr size_t inline_size = CPPA_INLINE_MESSAGE_SIZE;
+
+    // number of unreleased parts, i.e., the element itself and its
+    // embedded tuple, or 0 if msg does not use the inline storage
+    std::atomic<int> m_parts;
+
+    // set by make_embedded() until create() takes over this element
+    bool m_unclaimed;
+
+    std::aligned_storage<(inline_size > 0 ? inline_size : 1)>::type m_storage;
+
 };
 
+template<typename... Ts>
+any_tuple mailbox_element::make_embedded(Ts&&... args) {
+    typedef detail::tuple_vals<
+                typename detail::strip_and_convert<Ts>::type...
+            >
+            vals_type;
+    typedef detail::embedded_tuple<vals_type> embedded_type;
+    if (   sizeof(embedded_type) > inline_size
+        || alignof(embedded_type) > alignof(decltype(m_storage))) {
+        return make_any_tuple(std::forward<Ts>(args)...);
+    }
+    auto e = detail::memory::create<mailbox_element>();
+    detail::abstract_tuple* ptr;
+    try {
+        ptr = ::new (&e->m_storage) embedded_type(e, std::forward<Ts>(args)...);
+    }
+    catch (...) {
+        e->request_deletion();
+        throw;
+    }
+    // the element is released along with the tuple until claimed
+    e->m_parts = 1;
+    e->m_unclaimed = true;
+    return any_tuple{ptr};
+}
+
 } // namespace cppa
 
 #endif // CPPA_RECURSIVE_QUEUE_NODE_HPP
@@ -0,0 +1,86 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+#ifndef CPPA_MAILBOX_OVERFLOW_HPP
+#define CPPA_MAILBOX_OVERFLOW_HPP
+
+namespace cppa {
+
+/**
+ * @brief Denotes how an actor with a bounded mailbox handles
+ *        messages that arrive while its mailbox is full.
+ * @see bounded_mailbox()
+ */
+enum class mailbox_overflow {
+
+    /**
+     * @brief Discards the arriving message.
+     * @note Synchronous requests receive <tt>{'OVERFLOW', receiver}</tt>
+     *       as response, since their senders would wait forever otherwise.
+     */
+    drop_newest,
+
+    /**
+     * @brief Discards the oldest messages whenever the actor
+     *        dequeues its next message.
+     *
+     * Senders cannot remove messages from the mailbox, i.e., the mailbox
+     * holds up to twice its capacity until the actor dequeues again.
+     * Messages arriving at a mailbox with twice its capacity are
+     * rejected as if the policy was {@link reject}.
+     * @note Synchronous requests receive <tt>{'OVERFLOW', receiver}</tt>
+     *       as response when discarded.
+     */
+    drop_oldest,
+
+    /**
+     * @brief Discards the arriving message and sends
+     *        <tt>{'OVERFLOW', receiver}</tt> to its sender.
+     */
+    reject,
+
+    /**
+     * @brief Enqueues the arriving message but suspends the sending
+     *        event-based actor after its current message until the
+     *        mailbox is no longer full.
+     *
+     * A suspended sender finishes its current message, i.e., the mailbox
+     * holds up to twice its capacity. Messages arriving at a mailbox with
+     * twice its capacity and messages from senders that cannot be
+     * suspended, i.e., from anything but the event-based actor running
+     * in the sending thread, are rejected as if the policy was
+     * {@link reject}.
+     */
+    suspend_sender
+
+};
+
+} // namespace cppa
+
+#endif // CPPA_MAILBOX_OVERFLOW_HPP
@@ -0,0 +1,77 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_MAILBOX_STATS_HPP
+#define CPPA_MAILBOX_STATS_HPP
+
+#include <cstddef>
+
+#include "cppa/actor.hpp"
+
+namespace cppa {
+
+/**
+ * @brief A snapshot of the mailbox counters of a local actor.
+ * @note All values are approximated while the actor is running.
+ * @see detail::actor_registry::largest_mailboxes()
+ */
+struct mailbox_stats {
+
+    /**
+     * @brief The ID of the actor owning the mailbox.
+     */
+    actor_id id;
+
+    /**
+     * @brief The number of messages waiting in the mailbox.
+     */
+    size_t size;
+
+    /**
+     * @brief The largest backlog observed by the actor
+     *        when fetching new messages from its mailbox.
+     */
+    size_t high_water_mark;
+
+    /**
+     * @brief The number of messages enqueued so far.
+     */
+    size_t enqueued;
+
+    /**
+     * @brief The number of messages dequeued so far.
+     */
+    size_t dequeued;
+
+};
+
+} // namespace cppa
+
+#endif // CPPA_MAILBOX_STATS_HPP
@@ -63,16 +63,12 @@ class memory_cached : public Base {
                                 , outer_memory(nullptr) { }
 
     virtual void request_deletion() {
-        auto mc = detail::memory::get_cache_map_entry(&typeid(*this));
-        if (!mc) {
-            auto om = outer_memory;
-            if (om) {
-                om->destroy();
-                om->deallocate();
-            }
-            else delete this;
+        auto om = outer_memory;
+        if (om) {
+            auto mc = om->thread_cache();
+            mc->release_instance(mc->downcast(this));
         }
-        else mc->release_instance(mc->downcast(this));
+        else delete this;
     }
 
  private:
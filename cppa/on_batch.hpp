@@ -0,0 +1,131 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_ON_BATCH_HPP
+#define CPPA_ON_BATCH_HPP
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+
+#include "cppa/on.hpp"
+#include "cppa/self.hpp"
+#include "cppa/any_tuple.hpp"
+#include "cppa/local_actor.hpp"
+#include "cppa/mailbox_element.hpp"
+
+#include "cppa/detail/memory.hpp"
+#include "cppa/detail/types_array.hpp"
+
+namespace cppa { namespace detail {
+
+template<typename T>
+bool is_batch_element(const any_tuple& msg) {
+    return msg.size() == 1 && msg.type_at(0) == static_types_array<T>::arr[0];
+}
+
+// appends pending messages of type T to xs until xs has max elements
+template<typename T>
+void collect_batch(std::vector<T>& xs, size_t max) {
+    auto s = self.get();
+    while (xs.size() < max) {
+        auto e = s->dequeue_batch_element(is_batch_element<T>);
+        if (e == nullptr) return;
+        xs.push_back(e->msg.template get_as<T>(0));
+        disposer{}(e);
+    }
+}
+
+template<typename T, typename F>
+class batch_handler {
+
+ public:
+
+    batch_handler(F fun, size_t max) : m_fun(std::move(fun)), m_max(max) { }
+
+    void operator()(const T& first) const {
+        std::vector<T> xs;
+        xs.push_back(first);
+        collect_batch(xs, m_max);
+        m_fun(xs);
+    }
+
+ private:
+
+    mutable F m_fun;
+    size_t m_max;
+
+};
+
+template<typename T>
+class batch_rvalue_builder {
+
+ public:
+
+    constexpr batch_rvalue_builder(size_t max) : m_max(max) { }
+
+    template<typename F>
+    auto operator>>(F fun) const
+    -> decltype(on<T>() >> std::declval<batch_handler<T, F>>()) {
+        return on<T>() >> batch_handler<T, F>{std::move(fun), m_max};
+    }
+
+ private:
+
+    size_t m_max;
+
+};
+
+} } // namespace cppa::detail
+
+namespace cppa {
+
+/**
+ * @brief Matches messages consisting of a single @p T and passes
+ *        up to @p max_batch_size of them as <tt>std::vector<T></tt>
+ *        to the callback, e.g., <tt>on_batch<int>() >> [](const
+ *        std::vector<int>& xs) { ... }</tt>.
+ *
+ * An event-based actor appends all asynchronous messages of type @p T
+ * pending in its mailbox directly after the matched message, i.e., the
+ * actor still handles messages in the order they were received. In all
+ * other cases, as well as while the actor has skipped messages, the
+ * callback receives a batch of size one. The callback cannot reply to
+ * the batched messages and <tt>self->last_sender()</tt> refers to the
+ * sender of the first message in the batch.
+ */
+template<typename T>
+constexpr detail::batch_rvalue_builder<T> on_batch(size_t max_batch_size = 1024) {
+    return {max_batch_size};
+}
+
+} // namespace cppa
+
+#endif // CPPA_ON_BATCH_HPP
@@ -46,7 +46,7 @@ class prioritizing : public Base {
 
     mailbox_element* try_pop() override {
         auto result = m_high_priority_mailbox.try_pop();
-        return (result) ? result : this->m_mailbox.try_pop();
+        return (result) ? result : this->dequeue_message();
     }
 
     template<typename... Ts>
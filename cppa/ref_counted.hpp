@@ -53,19 +53,30 @@ class ref_counted : public memory_managed {
 
     /**
      * @brief Increases reference count by one.
+     * @note A new reference is always created from an existing one,
+     *       i.e., no ordering constraints are required.
      */
-    inline void ref() { ++m_rc; }
+    inline void ref() { m_rc.fetch_add(1, std::memory_order_relaxed); }
 
     /**
      * @brief Decreases reference count by one and calls
      *        @p request_deletion when it drops to zero.
      */
-    inline void deref() { if (--m_rc == 0) request_deletion(); }
+    inline void deref() {
+        // release our writes to the thread deleting this object,
+        // which in turn acquires the writes of all other owners
+        if (m_rc.fetch_sub(1, std::memory_order_release) == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            request_deletion();
+        }
+    }
 
     /**
      * @brief Queries whether there is exactly one reference.
      */
-    inline bool unique() const { return m_rc == 1; }
+    inline bool unique() const {
+        return m_rc.load(std::memory_order_acquire) == 1;
+    }
 
     inline size_t get_reference_count() const { return m_rc; }
 
@@ -54,9 +54,21 @@ namespace util { struct fiber; }
 
 enum class resume_result {
     actor_blocked,
+    actor_preempted,
+    actor_suspended,
     actor_done
 };
 
+/**
+ * @brief Denotes the class of an actor in the scheduler's job queue.
+ *        Workers run ready actors of higher classes first.
+ */
+enum class scheduling_priority {
+    high,
+    normal,
+    low
+};
+
 enum scheduled_actor_type {
     context_switching_impl,  // enqueued to the job queue on startup
     event_based_impl,        // not enqueued to the job queue on startup
@@ -84,11 +96,9 @@ class scheduled_actor : public extend<local_actor>::with<mailbox_based, threadle
 
     /**
      * @brief Continues execution of this actor.
-     * @param next_job Denotes the next actor to be resumed, should be
-     *                 set in case of chaining.
      * @note This member function is called from the scheduler's worker threads.
      */
-    virtual resume_result resume(util::fiber* from, actor_ptr& next_job) = 0;
+    virtual resume_result resume(util::fiber* from) = 0;
 
     /**
      * @brief Called once by the scheduler after actor is initialized,
@@ -116,15 +126,46 @@ class scheduled_actor : public extend<local_actor>::with<mailbox_based, threadle
 
     virtual void run_detached();
 
-    void enqueue(const message_header&, any_tuple) override;
+    /**
+     * @brief Limits the number of messages handled per call to
+     *        {@link resume()}; 0 means unlimited.
+     * @note Only event-based actors evaluate this setting. An actor that
+     *       exceeds its budget returns @p resume_result::actor_preempted.
+     */
+    inline void max_throughput(size_t num_messages) {
+        m_max_throughput = num_messages;
+    }
 
-    bool chained_enqueue(const message_header&, any_tuple) override;
+    inline size_t max_throughput() const {
+        return m_max_throughput;
+    }
 
-    void unchain() override;
+    /**
+     * @brief Sets the scheduling class of this actor.
+     * @note Must not be changed while this actor is ready to run.
+     */
+    inline void priority(scheduling_priority value) {
+        m_priority = value;
+    }
+
+    inline scheduling_priority priority() const {
+        return m_priority;
+    }
+
+    /**
+     * @brief Returns the number of messages processed by scheduled
+     *        actors in the calling thread since the last call and
+     *        resets the counter.
+     */
+    static std::uint64_t fetch_processed_messages();
+
+    void enqueue(const message_header&, any_tuple) override;
+
+    scheduled_actor* enqueue_batched(const message_header&, any_tuple) override;
 
  protected:
 
-    scheduled_actor(actor_state init_state, bool enable_chained_send);
+    scheduled_actor(actor_state init_state);
 
     void cleanup(std::uint32_t reason) override;
 
@@ -143,9 +184,17 @@ class scheduled_actor : public extend<local_actor>::with<mailbox_based, threadle
 
     bool initialized() const;
 
+    /**
+     * @brief Adds @p num to the number of messages processed
+     *        in the calling thread.
+     */
+    static void add_processed_messages(size_t num);
+
  private:
 
-    bool enqueue_impl(actor_state, const message_header&, any_tuple&&);
+    // returns true if the caller has to schedule this actor
+    bool enqueue_impl(bool schedule, const message_header& hdr,
+                      any_tuple&& msg);
 
     std::atomic<actor_state> m_state;
 
@@ -153,6 +202,8 @@ class scheduled_actor : public extend<local_actor>::with<mailbox_based, threadle
 
     scheduler* m_scheduler;
     bool m_hidden;
+    size_t m_max_throughput;
+    scheduling_priority m_priority;
 
 };
 
@@ -33,6 +33,7 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include <functional>
 #include <type_traits>
@@ -44,6 +45,7 @@
 #include "cppa/attachable.hpp"
 #include "cppa/local_actor.hpp"
 #include "cppa/spawn_options.hpp"
+#include "cppa/scheduler_statistics.hpp"
 //#include "cppa/scheduled_actor.hpp"
 
 #include "cppa/util/duration.hpp"
@@ -92,6 +94,13 @@ class scheduler {
 
     virtual void enqueue(scheduled_actor*) = 0;
 
+    /**
+     * @brief Enqueues all actors in @p what at once.
+     * @note The default implementation calls {@link enqueue()}
+     *       for each actor.
+     */
+    virtual void enqueue_batch(const std::vector<scheduled_actor*>& what);
+
     /**
      * @brief Informs the scheduler about a converted context
      *        (a thread that acts as actor).
@@ -107,6 +116,12 @@ class scheduler {
      */
     virtual attachable* register_hidden_context();
 
+    /**
+     * @brief Returns a snapshot of the counters of this scheduler.
+     * @note The default implementation returns no worker statistics.
+     */
+    virtual scheduler_statistics statistics() const;
+
     template<typename Duration, typename... Data>
     void delayed_send(message_header hdr,
                       const Duration& rel_time,
@@ -177,6 +192,12 @@ void set_scheduler(scheduler* sched);
  */
 void set_default_scheduler(size_t num_threads);
 
+/**
+ * @brief Sets a work-stealing scheduler with @p num_threads worker threads.
+ * @throws std::runtime_error if there's already a scheduler defined.
+ */
+void set_work_stealing_scheduler(size_t num_threads);
+
 } // namespace cppa
 
 #endif // CPPA_SCHEDULER_HPP
@@ -0,0 +1,139 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_SCHEDULER_STATISTICS_HPP
+#define CPPA_SCHEDULER_STATISTICS_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace cppa {
+
+/**
+ * @brief Counters of a single worker thread.
+ */
+struct worker_statistics {
+
+    /**
+     * @brief Number of actors resumed by this worker.
+     */
+    std::uint64_t jobs;
+
+    /**
+     * @brief Number of messages processed by resumed actors.
+     */
+    std::uint64_t messages;
+
+    /**
+     * @brief Number of jobs stolen from other workers.
+     */
+    std::uint64_t steals;
+
+    /**
+     * @brief Time spent running actors.
+     */
+    std::chrono::nanoseconds busy;
+
+    /**
+     * @brief Time spent waiting for jobs.
+     */
+    std::chrono::nanoseconds idle;
+
+    /**
+     * @brief Returns the average duration of a single resume.
+     */
+    inline std::chrono::nanoseconds avg_resume_duration() const {
+        return std::chrono::nanoseconds(jobs == 0 ? 0 : busy.count()
+                                        / static_cast<std::int64_t>(jobs));
+    }
+
+    /**
+     * @brief Returns the fraction of time this worker was busy.
+     */
+    inline double utilization() const {
+        auto total = busy.count() + idle.count();
+        return total == 0 ? 0.0 : static_cast<double>(busy.count()) / total;
+    }
+
+};
+
+/**
+ * @brief A snapshot of the counters of a scheduler.
+ * @see scheduler::statistics()
+ */
+struct scheduler_statistics {
+
+    /**
+     * @brief Number of currently active workers.
+     */
+    size_t active_workers;
+
+    /**
+     * @brief Number of threads running detached or blocking actors,
+     *        including idle threads waiting for the next actor.
+     */
+    size_t detached_threads;
+
+    /**
+     * @brief Number of idle threads for detached actors.
+     */
+    size_t idle_detached_threads;
+
+    /**
+     * @brief Maximum number of threads for detached actors
+     *        that ran concurrently.
+     */
+    size_t peak_detached_threads;
+
+    /**
+     * @brief Counters of all workers, indexed by worker ID.
+     */
+    std::vector<worker_statistics> workers;
+
+    /**
+     * @brief Returns the sum of all worker counters.
+     */
+    worker_statistics total() const;
+
+};
+
+/**
+ * @brief Returns a human-readable representation of @p stats.
+ * @relates scheduler_statistics
+ */
+std::string to_string(const scheduler_statistics& stats);
+
+} // namespace cppa
+
+#endif // CPPA_SCHEDULER_STATISTICS_HPP
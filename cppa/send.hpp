@@ -31,15 +31,20 @@
 #ifndef CPPA_SEND_HPP
 #define CPPA_SEND_HPP
 
+#include <vector>
+#include <utility>
+
 #include "cppa/self.hpp"
 #include "cppa/actor.hpp"
 #include "cppa/any_tuple.hpp"
 #include "cppa/exit_reason.hpp"
+#include "cppa/mailbox_element.hpp"
 #include "cppa/message_header.hpp"
 #include "cppa/message_future.hpp"
 #include "cppa/typed_actor_ptr.hpp"
 
 #include "cppa/util/duration.hpp"
+#include "cppa/util/scope_guard.hpp"
 
 namespace cppa {
 
@@ -68,6 +73,16 @@ using channel_destination = destination_header<channel_ptr>;
 
 using actor_destination = destination_header<actor_ptr>;
 
+namespace detail {
+
+inline void send_tuple_impl(local_actor*,
+                            const message_header& hdr,
+                            any_tuple&& what) {
+    hdr.deliver(std::move(what));
+}
+
+} // namespace detail
+
 /**
  * @brief Sends @p what to the receiver specified in @p hdr.
  */
@@ -75,13 +90,32 @@ inline void send_tuple(channel_destination dest, any_tuple what) {
     if (dest.receiver == nullptr) return;
     auto s = self.get();
     message_header fhdr{s, std::move(dest.receiver), dest.priority};
-    if (fhdr.receiver != s && s->chaining_enabled()) {
-        if (fhdr.receiver->chained_enqueue(fhdr, std::move(what))) {
-            // only actors implement chained_enqueue to return true
-            s->chained_actor(fhdr.receiver.downcast<actor>());
-        }
-    }
-    else fhdr.deliver(std::move(what));
+    detail::send_tuple_impl(s, fhdr, std::move(what));
+}
+
+/**
+ * @brief Sends @p what to @p whom without changing the reference
+ *        count of @p whom or of the sender.
+ *
+ * The caller keeps @p whom alive and @p self outlives this call, i.e.,
+ * the message header can borrow both pointers. Only the mailbox element
+ * created by the receiver holds a new reference to the sender.
+ */
+template<typename C>
+inline void send_tuple(const intrusive_ptr<C>& whom, any_tuple what) {
+    static_assert(std::is_convertible<C*, channel*>::value,
+                  "illegal receiver");
+    if (whom == nullptr) return;
+    auto s = self.get();
+    message_header fhdr{nullptr, nullptr, message_priority::normal};
+    fhdr.sender.adopt(s);
+    fhdr.receiver.adopt(whom.get());
+    auto guard = util::make_scope_guard([&] {
+        // give back the borrowed pointers without decrementing
+        static_cast<void>(fhdr.sender.release());
+        static_cast<void>(fhdr.receiver.release());
+    });
+    detail::send_tuple_impl(s, fhdr, std::move(what));
 }
 
 /**
@@ -110,7 +144,19 @@ void send(const typed_actor_ptr<Signatures...>& dest, Ts&&... what) {
 template<typename... Ts>
 inline void send(channel_destination dest, Ts&&... what) {
     static_assert(sizeof...(Ts) > 0, "no message to send");
-    send_tuple(std::move(dest), make_any_tuple(std::forward<Ts>(what)...));
+    send_tuple(std::move(dest),
+               mailbox_element::make_embedded(std::forward<Ts>(what)...));
+}
+
+/**
+ * @brief Sends <tt>{what...}</tt> to @p whom without changing
+ *        any reference count (see {@link send_tuple()}).
+ * @pre <tt>sizeof...(Ts) > 0</tt>
+ */
+template<typename C, typename... Ts>
+inline void send(const intrusive_ptr<C>& whom, Ts&&... what) {
+    static_assert(sizeof...(Ts) > 0, "no message to send");
+    send_tuple(whom, mailbox_element::make_embedded(std::forward<Ts>(what)...));
 }
 
 /**
@@ -132,7 +178,30 @@ inline void send_tuple_as(actor_ptr from, channel_destination dest, any_tuple wh
 template<typename... Ts>
 inline void send_as(actor_ptr from, channel_destination dest, Ts&&... what) {
     send_tuple_as(std::move(from), std::move(dest),
-                  make_any_tuple(std::forward<Ts>(what)...));
+                  mailbox_element::make_embedded(std::forward<Ts>(what)...));
+}
+
+/**
+ * @brief A list of receivers along with the message for each receiver.
+ */
+typedef std::vector<std::pair<channel_ptr, any_tuple>> message_batch;
+
+/**
+ * @brief Sends each message in @p msgs to its receiver, but sets
+ *        the sender information to @p from.
+ *
+ * Unlike calling {@link send_tuple_as()} for each message, this function
+ * reserves all mailbox elements in the memory cache at once and
+ * passes all actors that became ready to the scheduler at once.
+ */
+void send_batch_as(const actor_ptr& from, message_batch msgs);
+
+/**
+ * @brief Sends each message in @p msgs to its receiver.
+ * @see send_batch_as()
+ */
+inline void send_batch(message_batch msgs) {
+    send_batch_as(self, std::move(msgs));
 }
 
 /**
@@ -160,7 +229,8 @@ template<typename... Ts>
 inline message_future sync_send(actor_destination dest, Ts&&... what) {
     static_assert(sizeof...(Ts) > 0, "no message to send");
     return sync_send_tuple(std::move(dest),
-                           make_any_tuple(std::forward<Ts>(what)...));
+                           mailbox_element::make_embedded(
+                               std::forward<Ts>(what)...));
 }
 
 /**
@@ -259,7 +329,8 @@ message_future timed_sync_send(actor_destination whom,
     static_assert(sizeof...(Ts) > 0, "no message to send");
     return timed_sync_send_tuple(std::move(whom),
                                  rtime,
-                                 make_any_tuple(std::forward<Ts>(what)...));
+                                 mailbox_element::make_embedded(
+                                     std::forward<Ts>(what)...));
 }
 
 /**
@@ -285,7 +356,7 @@ CPPA_DEPRECATED inline void reply(Ts&&... what) {
 template<typename... Ts>
 inline void reply_to(const response_handle& handle, Ts&&... what) {
     if (handle.valid()) {
-        handle.apply(make_any_tuple(std::forward<Ts>(what)...));
+        handle.apply(mailbox_element::make_embedded(std::forward<Ts>(what)...));
     }
 }
 
@@ -31,6 +31,10 @@
 #ifndef CPPA_SPAWN_OPTIONS_HPP
 #define CPPA_SPAWN_OPTIONS_HPP
 
+#include <cstdint>
+
+#include "cppa/mailbox_overflow.hpp"
+
 namespace cppa {
 
 /**
@@ -44,14 +48,17 @@ namespace cppa {
 #ifdef CPPA_DOCUMENTATION
 class spawn_options { };
 #else
-enum class spawn_options : int {
+enum class spawn_options : std::uint64_t {
     no_flags            = 0x00,
     link_flag           = 0x01,
     monitor_flag        = 0x02,
     detach_flag         = 0x04,
     hide_flag           = 0x08,
     blocking_api_flag   = 0x10,
-    priority_aware_flag = 0x20
+    priority_aware_flag = 0x20,
+    high_priority_flag  = 0x40,
+    low_priority_flag   = 0x80,
+    sharded_mailbox_flag = 0x100
 };
 #endif
 
@@ -61,8 +68,8 @@ enum class spawn_options : int {
  */
 constexpr spawn_options operator+(const spawn_options& lhs,
                                   const spawn_options& rhs) {
-    return static_cast<spawn_options>( static_cast<int>(lhs)
-                                     | static_cast<int>(rhs));
+    return static_cast<spawn_options>( static_cast<std::uint64_t>(lhs)
+                                     | static_cast<std::uint64_t>(rhs));
 }
 
 #ifndef CPPA_DOCUMENTATION
@@ -111,6 +118,30 @@ constexpr spawn_options blocking_api     = spawn_options::blocking_api_flag;
 constexpr spawn_options priority_aware   = spawn_options::priority_aware_flag
                                          + spawn_options::detach_flag;
 
+/**
+ * @brief Causes the scheduler to run the new actor before ready actors
+ *        without this flag, e.g., for latency-critical actors.
+ * @note Has no effect on detached actors.
+ */
+constexpr spawn_options high_scheduling_priority = spawn_options::high_priority_flag;
+
+/**
+ * @brief Causes the scheduler to run the new actor only if no ready actor
+ *        of a higher class is waiting, e.g., for background jobs.
+ *        The scheduler ages waiting actors to prevent starvation.
+ * @note Has no effect on detached actors.
+ */
+constexpr spawn_options low_scheduling_priority = spawn_options::low_priority_flag;
+
+/**
+ * @brief Causes the new actor to use a mailbox with one stack per
+ *        group of senders rather than a single stack every sender
+ *        competes for, e.g., for logging or aggregating actors
+ *        receiving messages from many threads at once.
+ * @note Messages from the same sender are still received in order.
+ */
+constexpr spawn_options sharded_mailbox = spawn_options::sharded_mailbox_flag;
+
 #ifndef CPPA_DOCUMENTATION
 } // namespace <anonymous>
 #endif
@@ -120,7 +151,8 @@ constexpr spawn_options priority_aware   = spawn_options::priority_aware_flag
  * @relates spawn_options
  */
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
-    return (static_cast<int>(haystack) & static_cast<int>(needle)) != 0;
+    return (  static_cast<std::uint64_t>(haystack)
+            & static_cast<std::uint64_t>(needle)) != 0;
 }
 
 /**
@@ -171,6 +203,120 @@ constexpr bool has_blocking_api_flag(spawn_options opts) {
     return has_spawn_option(opts, blocking_api);
 }
 
+/**
+ * @brief Checks wheter the {@link high_scheduling_priority}
+ *        flag is set in @p opts.
+ * @relates spawn_options
+ */
+constexpr bool has_high_priority_flag(spawn_options opts) {
+    return has_spawn_option(opts, high_scheduling_priority);
+}
+
+/**
+ * @brief Checks wheter the {@link low_scheduling_priority}
+ *        flag is set in @p opts.
+ * @relates spawn_options
+ */
+constexpr bool has_low_priority_flag(spawn_options opts) {
+    return has_spawn_option(opts, low_scheduling_priority);
+}
+
+/**
+ * @brief Checks wheter the {@link sharded_mailbox} flag is set in @p opts.
+ * @relates spawn_options
+ */
+constexpr bool has_sharded_mailbox_flag(spawn_options opts) {
+    return has_spawn_option(opts, sharded_mailbox);
+}
+
+/** @cond PRIVATE */
+
+constexpr int max_throughput_shift = 20;
+
+constexpr int max_throughput_mask = 0x7FF;
+
+/** @endcond */
+
+/**
+ * @brief Causes an event-based actor to handle at most @p num_messages
+ *        messages each time it is resumed by the scheduler. Afterwards,
+ *        the actor is re-enqueued at the tail of the job queue to give
+ *        other actors a chance to run.
+ *
+ * By default, an actor keeps its worker as long as its mailbox is not
+ * empty. Latency-critical actors should use a small budget, whereas
+ * batch-processing actors benefit from larger budgets.
+ * @note The budget is stored in 11 bits of {@link spawn_options}, i.e.,
+ *       values above 2047 are clamped to 2047 and values below 1 select
+ *       the default (unlimited) behavior.
+ * @relates spawn_options
+ */
+constexpr spawn_options max_throughput(int num_messages) {
+    return static_cast<spawn_options>(
+               static_cast<std::uint64_t>(
+                   num_messages <= 0 ? 0
+                   : (num_messages > max_throughput_mask ? max_throughput_mask
+                                                         : num_messages))
+            << max_throughput_shift);
+}
+
+/**
+ * @brief Returns the message budget per resume set via
+ *        {@link max_throughput()} in @p opts or 0 if unlimited.
+ * @relates spawn_options
+ */
+constexpr int get_max_throughput(spawn_options opts) {
+    return static_cast<int>(  (static_cast<std::uint64_t>(opts)
+                               >> max_throughput_shift)
+                            & max_throughput_mask);
+}
+
+/** @cond PRIVATE */
+
+constexpr int mailbox_overflow_shift = 9;
+
+constexpr int mailbox_capacity_shift = 32;
+
+/** @endcond */
+
+/**
+ * @brief Limits the mailbox of the new actor to @p capacity messages
+ *        and selects how messages arriving at a full mailbox are handled.
+ *
+ * The mailbox of an actor is unbounded by default, i.e., a slow
+ * receiver lets a fast sender grow memory without limit.
+ * @pre <tt>capacity > 0</tt>
+ * @relates spawn_options
+ */
+constexpr spawn_options bounded_mailbox(std::uint32_t capacity,
+                                        mailbox_overflow policy
+                                            = mailbox_overflow::drop_newest) {
+    return static_cast<spawn_options>(
+                (static_cast<std::uint64_t>(capacity) << mailbox_capacity_shift)
+              | (static_cast<std::uint64_t>(policy) << mailbox_overflow_shift));
+}
+
+/**
+ * @brief Returns the mailbox capacity set via {@link bounded_mailbox()}
+ *        in @p opts or 0 if the mailbox is unbounded.
+ * @relates spawn_options
+ */
+constexpr std::uint32_t get_mailbox_capacity(spawn_options opts) {
+    return static_cast<std::uint32_t>(  static_cast<std::uint64_t>(opts)
+                                      >> mailbox_capacity_shift);
+}
+
+/**
+ * @brief Returns the overflow policy set via
+ *        {@link bounded_mailbox()} in @p opts.
+ * @relates spawn_options
+ */
+constexpr mailbox_overflow get_mailbox_overflow(spawn_options opts) {
+    return static_cast<mailbox_overflow>(  (static_cast<std::uint64_t>(opts)
+                                            >> mailbox_overflow_shift)
+                                         & 0x3);
+}
+
 /** @} */
 
 } // namespace cppa
@@ -74,7 +74,7 @@ class threaded : public Base {
     inline bool waits_for_timeout(std::uint32_t) { return false; }
 
     virtual mailbox_element* try_pop() {
-        return this->m_mailbox.try_pop();
+        return this->dequeue_message();
     }
 
     mailbox_element* pop() {
@@ -116,8 +116,10 @@ class threaded : public Base {
     void enqueue_impl(typename Base::mailbox_type& mbox,
                       const message_header& hdr,
                       any_tuple&& msg) {
+        // only the default mailbox is bounded
+        if (&mbox == &this->m_mailbox && !this->admit_message(hdr)) return;
         auto ptr = this->new_mailbox_element(hdr, std::move(msg));
-        switch (mbox.enqueue(ptr)) {
+        switch (this->enqueue_message(mbox, ptr)) {
             case intrusive::first_enqueued: {
                 lock_type guard(m_mtx);
                 m_cv.notify_one();
@@ -137,9 +139,10 @@ class threaded : public Base {
         enqueue_impl(this->m_mailbox, hdr, std::move(msg));
     }
 
-    bool chained_enqueue(const message_header& hdr, any_tuple msg) override {
+    scheduled_actor* enqueue_batched(const message_header& hdr,
+                                     any_tuple msg) override {
         enqueue(hdr, std::move(msg));
-        return false;
+        return nullptr;
     }
 
     timeout_type init_timeout(const util::duration& rel_time) {
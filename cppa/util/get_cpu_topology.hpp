@@ -0,0 +1,51 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_UTIL_GET_CPU_TOPOLOGY_HPP
+#define CPPA_UTIL_GET_CPU_TOPOLOGY_HPP
+
+#include <vector>
+
+namespace cppa { namespace util {
+
+/**
+ * @brief Returns the IDs of all CPUs available to this process,
+ *        grouped by NUMA node.
+ *
+ * Returns a single node containing the CPUs <tt>0 ... N-1</tt>, where
+ * @p N is <tt>std::thread::hardware_concurrency()</tt>, if the platform
+ * does not provide NUMA information.
+ */
+std::vector<std::vector<int>> get_cpu_topology();
+
+} } // namespace cppa::util
+
+#endif // CPPA_UTIL_GET_CPU_TOPOLOGY_HPP
@@ -31,13 +31,13 @@
 #ifndef CPPA_PRODUCER_CONSUMER_LIST_HPP
 #define CPPA_PRODUCER_CONSUMER_LIST_HPP
 
-#define CPPA_CACHE_LINE_SIZE 64
-
 #include <chrono>
 #include <thread>
 #include <atomic>
 #include <cassert>
 
+#include "cppa/config.hpp"
+
 // GCC hack
 #if !defined(_GLIBCXX_USE_SCHED_YIELD) && !defined(__clang__)
 #include <time.h>
@@ -146,6 +146,27 @@ class producer_consumer_list {
         m_producer_lock = false;
     }
 
+    // appends all elements in [first, last) with a single publish
+    template<typename Iterator>
+    void push_back(Iterator first, Iterator last) {
+        if (first == last) return;
+        // link new nodes before acquiring exclusivity
+        node* head = new node(*first);
+        node* tail = head;
+        for (++first; first != last; ++first) {
+            assert(*first != nullptr);
+            node* tmp = new node(*first);
+            tail->next.store(tmp, std::memory_order_relaxed);
+            tail = tmp;
+        }
+        while (m_producer_lock.exchange(true)) {
+            std::this_thread::yield();
+        }
+        m_last->next = head;
+        m_last = tail;
+        m_producer_lock = false;
+    }
+
     // returns nullptr on failure
     pointer try_pop() {
         pointer result = nullptr;
@@ -0,0 +1,61 @@
+/******************************************************************************\
+ * This benchmark measures how many messages per second a group of threads    *
+ * can send to a single receiver, i.e., the threads constantly access the     *
+ * reference count of the same receiver and the same kind of message header.  *
+ * Usage: contended_send [SENDERS] [MSGS_PER_SENDER]                          *
+ *                                                                            *
+ * Note: the reference count traffic avoided by send() only contends if       *
+ * senders run in parallel. So far, this benchmark was run on a single-core   *
+ * machine only, i.e., a speedup on multi-core machines is expected but not   *
+ * verified.                                                                  *
+\******************************************************************************/
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+int main(int argc, char** argv) {
+    size_t num_senders = argc > 1 ? strtoul(argv[1], nullptr, 10)
+                                  : max(thread::hardware_concurrency(), 2u);
+    size_t num_msgs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000000;
+    auto total = num_senders * num_msgs;
+    actor_ptr client = self;
+    auto receiver = spawn([=] {
+        auto received = make_shared<size_t>(0);
+        become (
+            on(atom("msg")) >> [=] {
+                if (++*received == total) {
+                    send(client, atom("done"));
+                    self->quit();
+                }
+            }
+        );
+    });
+    // all senders share the same message, i.e., sending does not allocate
+    auto msg = make_any_tuple(atom("msg"));
+    auto t0 = chrono::high_resolution_clock::now();
+    vector<thread> senders;
+    for (size_t i = 0; i < num_senders; ++i) {
+        senders.emplace_back([=] {
+            for (size_t j = 0; j < num_msgs; ++j) send_tuple(receiver, msg);
+        });
+    }
+    for (auto& t : senders) t.join();
+    auto t1 = chrono::high_resolution_clock::now();
+    receive (
+        on(atom("done")) >> [] { }
+    );
+    auto us = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    cout << num_senders << " senders: " << (total * 1000000.0 / us)
+         << " messages/s" << endl;
+    await_all_others_done();
+    shutdown();
+}
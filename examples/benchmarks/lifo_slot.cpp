@@ -0,0 +1,96 @@
+/******************************************************************************\
+ * This benchmark compares ping pong and request/reply between two            *
+ * event-based actors with and without the LIFO slot of the thread pool,      *
+ * i.e., with lifo_slot_limit() set to its default and set to 0.              *
+ * Usage: lifo_slot [MESSAGES]                                                *
+\******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+void ping(size_t num_pings) {
+    auto pongs = make_shared<size_t>(0);
+    become (
+        on(atom("pong"), arg_match) >> [=](int value) -> any_tuple {
+            if (++*pongs >= num_pings) {
+                send_exit(self->last_sender(), exit_reason::user_shutdown);
+                self->quit();
+            }
+            return {atom("ping"), value};
+        }
+    );
+}
+
+void pong(actor_ptr ping_actor) {
+    send(ping_actor, atom("pong"), 0); // kickoff
+    become (
+        on(atom("ping"), arg_match) >> [](int value) -> any_tuple {
+            return {atom("pong"), value + 1};
+        }
+    );
+}
+
+void request_loop(actor_ptr server, size_t remaining) {
+    if (remaining == 0) {
+        send_exit(server, exit_reason::user_shutdown);
+        self->quit();
+        return;
+    }
+    sync_send(server, atom("request")).then(
+        on(atom("reply")) >> [=] {
+            request_loop(server, remaining - 1);
+        }
+    );
+}
+
+template<typename F>
+void run(const char* name, size_t num_msgs, F fun) {
+    auto t0 = chrono::high_resolution_clock::now();
+    fun();
+    await_all_others_done();
+    auto t1 = chrono::high_resolution_clock::now();
+    auto ns = chrono::duration_cast<chrono::nanoseconds>(t1 - t0).count();
+    cout << name << ": " << (ns / static_cast<double>(num_msgs)) << " ns/msg"
+         << endl;
+}
+
+void run_all(const char* suffix, size_t num_msgs) {
+    string pp = "ping pong";
+    string rr = "request/reply";
+    run((pp + suffix).c_str(), num_msgs, [=] {
+        spawn(pong, spawn(ping, num_msgs));
+    });
+    run((rr + suffix).c_str(), num_msgs, [=] {
+        auto server = spawn([] {
+            become (
+                on(atom("request")) >> [] {
+                    return atom("reply");
+                }
+            );
+        });
+        spawn(request_loop, server, num_msgs);
+    });
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_msgs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    auto sched = new detail::work_stealing_scheduler;
+    set_scheduler(sched);
+    auto limit = sched->lifo_slot_limit();
+    sched->lifo_slot_limit(0);
+    run_all(" without LIFO slot", num_msgs);
+    sched->lifo_slot_limit(limit);
+    run_all(" with LIFO slot", num_msgs);
+    shutdown();
+}
@@ -0,0 +1,66 @@
+/******************************************************************************\
+ * This benchmark measures how many messages per second an actor receives     *
+ * from many threads sending at the same time, once using the default         *
+ * mailbox and once using a sharded mailbox (see spawn option                 *
+ * sharded_mailbox). Usage: mailbox_fan_in [PRODUCERS] [MSGS_PER_PRODUCER]    *
+ *                                                                            *
+ * Note: sharding can only pay off if producers run in parallel. So far,      *
+ * this benchmark was run on a single-core machine only, i.e., a speedup      *
+ * on multi-core machines is expected but not verified.                       *
+\******************************************************************************/
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+template<spawn_options Os>
+void run(const char* name, size_t num_producers, size_t num_msgs) {
+    auto total = num_producers * num_msgs;
+    actor_ptr client = self;
+    auto t0 = chrono::high_resolution_clock::now();
+    auto receiver = spawn<Os>([=] {
+        auto received = make_shared<size_t>(0);
+        become (
+            on(atom("msg")) >> [=] {
+                if (++*received == total) {
+                    send(client, atom("done"));
+                    self->quit();
+                }
+            }
+        );
+    });
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([=] {
+            for (size_t j = 0; j < num_msgs; ++j) send(receiver, atom("msg"));
+        });
+    }
+    receive (
+        on(atom("done")) >> [] { }
+    );
+    auto t1 = chrono::high_resolution_clock::now();
+    for (auto& t : producers) t.join();
+    auto us = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    cout << name << ": " << (total * 1000000.0 / us) << " messages/s" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_producers = argc > 1 ? strtoul(argv[1], nullptr, 10) : 64;
+    size_t num_msgs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 100000;
+    run<no_spawn_options>("default mailbox", num_producers, num_msgs);
+    run<sharded_mailbox>("sharded mailbox", num_producers, num_msgs);
+    await_all_others_done();
+    shutdown();
+}
@@ -0,0 +1,55 @@
+/******************************************************************************\
+ * This benchmark measures how many mailbox elements a single thread can      *
+ * create and release per second using libcppa's per-thread memory caches,    *
+ * compared to plain new/delete of an object with the same size.              *
+\******************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+#include "cppa/mailbox_element.hpp"
+#include "cppa/detail/memory.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+struct plain_object {
+    char data[sizeof(mailbox_element)];
+};
+
+template<typename F>
+void run(const char* name, size_t num_allocs, F fun) {
+    auto t0 = chrono::high_resolution_clock::now();
+    fun(num_allocs);
+    auto t1 = chrono::high_resolution_clock::now();
+    auto us = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    cout << name << ": " << (num_allocs * 1000000.0 / us) << " allocations/s"
+         << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_allocs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+    // a shared tuple, i.e., the benchmark does not allocate any tuple
+    auto msg = make_any_tuple(atom("ping"), 42);
+    message_header hdr;
+    detail::disposer dispose;
+    run("memory::create", num_allocs, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            dispose(mailbox_element::create(hdr, msg));
+        }
+    });
+    run("new/delete    ", num_allocs, [&](size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            // volatile prevents the compiler from eliding new/delete
+            plain_object* volatile ptr = new plain_object;
+            delete ptr;
+        }
+    });
+    shutdown();
+}
@@ -47,6 +47,14 @@ const std::type_info* abstract_tuple::type_token() const {
     return &typeid(void);
 }
 
+abstract_tuple* abstract_tuple::move_to(void*, size_t, embedding*) {
+    return nullptr;
+}
+
+embedding* abstract_tuple::embedded_in() const {
+    return nullptr;
+}
+
 const void* abstract_tuple::native_data() const {
     return nullptr;
 }
@@ -122,6 +122,10 @@ void actor::unlink_from(const actor_ptr& other) {
     static_cast<void>(unlink_from_impl(other));
 }
 
+size_t actor::mailbox_size() const {
+    return 0;
+}
+
 bool actor::remove_backlink(const actor_ptr& other) {
     if (other && other != this) {
         guard_type guard{m_mtx};
@@ -149,7 +153,7 @@ bool actor::establish_backlink(const actor_ptr& other) {
     }
     // send exit message without lock
     if (reason != exit_reason::not_exited) {
-        send_as(this, other, make_any_tuple(atom("EXIT"), reason));
+        send_as(this, other, atom("EXIT"), reason);
     }
     return false;
 }
@@ -30,13 +30,17 @@
 
 #include <mutex>
 #include <limits>
+#include <algorithm>
 #include <stdexcept>
 
 #include "cppa/self.hpp"
 #include "cppa/logging.hpp"
 #include "cppa/attachable.hpp"
 #include "cppa/exit_reason.hpp"
+#include "cppa/mailbox_element.hpp"
+#include "cppa/detail/memory.hpp"
 #include "cppa/detail/actor_registry.hpp"
+#include "cppa/intrusive/single_reader_queue.hpp"
 #include "cppa/util/shared_lock_guard.hpp"
 #include "cppa/util/upgrade_lock_guard.hpp"
 
@@ -143,4 +147,45 @@ void actor_registry::await_running_count_equal(size_t expected) {
     }
 }
 
+void actor_registry::add_mailbox(actor_id key, const mailbox_type* mbox) {
+    exclusive_guard guard(m_mailboxes_mtx);
+    // the owner closes its mailbox before calling remove_mailbox(),
+    // i.e., a closed mailbox must not be (re-)added by a late sender
+    if (!mbox->closed()) m_mailboxes[key] = mbox;
+}
+
+void actor_registry::remove_mailbox(actor_id key) {
+    exclusive_guard guard(m_mailboxes_mtx);
+    m_mailboxes.erase(key);
+}
+
+std::vector<mailbox_stats> actor_registry::largest_mailboxes(size_t n) const {
+    std::vector<mailbox_stats> result;
+    { // lifetime scope of guard
+        shared_guard guard(m_mailboxes_mtx);
+        result.reserve(m_mailboxes.size());
+        for (auto& kvp : m_mailboxes) {
+            auto mbox = kvp.second;
+            // load the consumer counter first (see single_reader_queue::size)
+            auto dequeued = mbox->total_dequeued();
+            auto enqueued = mbox->total_enqueued();
+            result.push_back(mailbox_stats{kvp.first,
+                                           enqueued - dequeued,
+                                           mbox->high_water_mark(),
+                                           enqueued,
+                                           dequeued});
+        }
+    }
+    auto by_size = [](const mailbox_stats& lhs, const mailbox_stats& rhs) {
+        return lhs.size > rhs.size;
+    };
+    if (n < result.size()) {
+        std::partial_sort(result.begin(), result.begin() + n, result.end(),
+                          by_size);
+        result.resize(n);
+    }
+    else std::sort(result.begin(), result.end(), by_size);
+    return result;
+}
+
 } } // namespace cppa::detail
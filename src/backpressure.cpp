@@ -0,0 +1,66 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+#include "cppa/atom.hpp"
+#include "cppa/self.hpp"
+#include "cppa/any_tuple.hpp"
+#include "cppa/event_based_actor.hpp"
+
+#include "cppa/detail/backpressure.hpp"
+
+namespace cppa { namespace detail {
+
+void notify_overflow(const actor_ptr& receiver,
+                     const actor_ptr& sender,
+                     const message_id& mid) {
+    if (sender == nullptr) return;
+    // a notification has no sender, because the sender
+    // could have a full mailbox as well
+    auto id = mid.is_request() ? mid.response_id() : message_id{};
+    sender->enqueue({nullptr, sender, id},
+                    make_any_tuple(atom("OVERFLOW"), receiver));
+}
+
+actor_ptr suspend_sender(const actor_ptr& sender) {
+    if (sender == nullptr || sender.get() != self.unchecked()) return nullptr;
+    // only event-based actors are able to yield after their current message
+    auto ptr = dynamic_cast<event_based_actor*>(sender.get());
+    if (ptr == nullptr) return nullptr;
+    ptr->begin_suspension();
+    return sender;
+}
+
+void resume_senders(std::vector<actor_ptr>& senders) {
+    for (auto& sender : senders) {
+        static_cast<event_based_actor*>(sender.get())->end_suspension();
+    }
+    senders.clear();
+}
+
+} } // namespace cppa::detail
@@ -68,13 +68,15 @@ class default_broker : public broker {
     : broker{std::forward<Ts>(args)...}, m_fun{move(fun)} { }
 
     void init() override {
-        enqueue(nullptr, make_any_tuple(atom("INITMSG")));
+        // set the initial behavior before enqueueing INITMSG, otherwise
+        // the middleman might process (and drop) it before become()
         become(
             on(atom("INITMSG")) >> [=] {
                 unbecome();
                 m_fun(this);
             }
         );
+        enqueue(nullptr, make_any_tuple(atom("INITMSG")));
     }
 
  private:
@@ -396,8 +398,9 @@ void broker::write(const connection_handle& hdl, const util::buffer& buf) {
 }
 
 void broker::write(const connection_handle& hdl, util::buffer&& buf) {
-    write(hdl, buf.size(), buf.data());
-    buf.clear();
+    auto i = m_io.find(hdl);
+    if (i != m_io.end()) i->second->write(std::move(buf));
+    else buf.clear();
 }
 
 local_actor_ptr init_and_launch(broker_ptr ptr) {
@@ -35,11 +35,10 @@ namespace cppa {
 
 channel::~channel() { }
 
-bool channel::chained_enqueue(const message_header& hdr, any_tuple msg) {
+scheduled_actor* channel::enqueue_batched(const message_header& hdr,
+                                          any_tuple msg) {
     enqueue(hdr, std::move(msg));
-    return false;
+    return nullptr;
 }
 
-void channel::unchain() { }
-
 } // namespace cppa
@@ -39,7 +39,7 @@
 namespace cppa {
 
 context_switching_actor::context_switching_actor(std::function<void()> fun)
-: super(actor_state::ready, true)
+: super(actor_state::ready)
 , m_fiber(&context_switching_actor::trampoline, this) {
     set_behavior(std::move(fun));
 }
@@ -56,7 +56,7 @@ mailbox_element* context_switching_actor::await_message(const timeout_type&) {
 }
 
 mailbox_element* context_switching_actor::await_message() {
-    auto e = m_mailbox.try_pop();
+    auto e = dequeue_message();
     while (e == nullptr) {
         if (m_mailbox.can_fetch_more() == false) {
             set_state(actor_state::about_to_block);
@@ -68,7 +68,7 @@ mailbox_element* context_switching_actor::await_message() {
             // wait until actor becomes rescheduled
             else detail::yield(detail::yield_state::blocked);
         }
-        e = m_mailbox.try_pop();
+        e = dequeue_message();
     }
     return e;
 }
@@ -95,32 +95,24 @@ scheduled_actor_type context_switching_actor::impl_type() {
     return context_switching_impl;
 }
 
-resume_result context_switching_actor::resume(util::fiber* from, actor_ptr& next_job) {
+resume_result context_switching_actor::resume(util::fiber* from) {
     CPPA_LOGMF(CPPA_TRACE, this, "state = " << static_cast<int>(state()));
     CPPA_REQUIRE(from != nullptr);
-    CPPA_REQUIRE(next_job == nullptr);
     using namespace detail;
     scoped_self_setter sss{this};
     for (;;) {
         switch (call(&m_fiber, from)) {
             case yield_state::done: {
-                CPPA_REQUIRE(next_job == nullptr);
-                m_chained_actor.swap(next_job);
                 return resume_result::actor_done;
             }
             case yield_state::ready: {
                 break;
             }
             case yield_state::blocked: {
-                CPPA_REQUIRE(next_job == nullptr);
-                m_chained_actor.swap(next_job);
-                CPPA_REQUIRE(m_chained_actor == nullptr);
                 switch (compare_exchange_state(actor_state::about_to_block,
                                                actor_state::blocked)) {
                     case actor_state::ready: {
-                        // restore variables
-                        m_chained_actor.swap(next_job);
-                        CPPA_REQUIRE(next_job == nullptr);
+                        // interrupted by arriving message
                         break;
                     }
                     case actor_state::blocked: {
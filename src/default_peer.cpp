@@ -30,6 +30,7 @@
 
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
 
 #include "cppa/on.hpp"
 #include "cppa/send.hpp"
@@ -59,6 +60,13 @@ using namespace std;
 
 namespace cppa { namespace io {
 
+namespace {
+
+// minimum number of bytes default_peer tries to read per recv
+constexpr size_t read_ahead_size = 64 * 1024;
+
+} // namespace <anonymous>
+
 default_peer::default_peer(default_protocol* parent,
                            const input_stream_ptr& in,
                            const output_stream_ptr& out,
@@ -66,10 +74,7 @@ default_peer::default_peer(default_protocol* parent,
 : super(parent->parent(), out, in->read_handle(), out->write_handle())
 , m_parent(parent), m_in(in)
 , m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
-, m_node(peer_ptr) {
-    m_rd_buf.final_size( m_state == wait_for_process_info
-                       ? sizeof(uint32_t) + process_information::node_id_size
-                       : sizeof(uint32_t));
+, m_node(peer_ptr), m_msg_size(0) {
     // state == wait_for_msg_size iff peer was created using remote_peer()
     // in this case, this peer must be erased if no proxy of it remains
     m_erase_on_last_proxy_exited = m_state == wait_for_msg_size;
@@ -97,97 +102,128 @@ void default_peer::io_failed(event_bitmask mask) {
 continue_reading_result default_peer::continue_reading() {
     CPPA_LOG_TRACE("");
     for (;;) {
+        // read as much as the socket has (up to read_ahead_size bytes,
+        // or more if the pending frame is larger) with a single recv
+        auto needed = frame_size();
+        auto buffered = m_rd_buf.size();
+        m_rd_buf.acquire(std::max(read_ahead_size,
+                                  needed > buffered ? needed - buffered : 0));
+        auto requested = m_rd_buf.remaining();
         try { m_rd_buf.append_from(m_in.get()); }
         catch (exception&) {
             return read_failure;
         }
-        if (!m_rd_buf.full()) return read_continue_later; // try again later
-        switch (m_state) {
-            case wait_for_process_info: {
-                //DEBUG("peer_connection::continue_reading: "
-                //      "wait_for_process_info");
-                uint32_t process_id;
-                process_information::node_id_type node_id;
-                memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(node_id.data(), m_rd_buf.offset_data(sizeof(uint32_t)),
-                       process_information::node_id_size);
-                m_node.reset(new process_information(process_id, node_id));
-                if (*process_information::get() == *m_node) {
-                    std::cerr << "*** middleman warning: "
-                                 "incoming connection from self"
-                              << std::endl;
-                    return read_failure;
-                }
-                CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
-                m_parent->register_peer(*m_node, this);
-                // initialization done
-                m_state = wait_for_msg_size;
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                break;
+        auto received = m_rd_buf.size() - buffered;
+        // handle all complete frames in the buffer
+        size_t pos = 0;
+        while (m_rd_buf.size() - pos >= frame_size()) {
+            auto frame = static_cast<const char*>(m_rd_buf.data()) + pos;
+            pos += frame_size();
+            if (!handle_frame(frame)) return read_failure;
+        }
+        // move the incomplete trailing frame (if any) to the front
+        if (pos > 0) m_rd_buf.erase_leading(pos);
+        // a short read means the socket has no more data for now
+        if (received < requested) return read_continue_later;
+    }
+}
+
+size_t default_peer::frame_size() const {
+    switch (m_state) {
+        case wait_for_process_info:
+            return sizeof(uint32_t) + process_information::node_id_size;
+        case wait_for_msg_size:
+            return sizeof(uint32_t);
+        default:
+            return m_msg_size;
+    }
+}
+
+bool default_peer::handle_frame(const char* frame) {
+    switch (m_state) {
+        case wait_for_process_info: {
+            //DEBUG("peer_connection::continue_reading: "
+            //      "wait_for_process_info");
+            uint32_t process_id;
+            process_information::node_id_type node_id;
+            memcpy(&process_id, frame, sizeof(uint32_t));
+            memcpy(node_id.data(), frame + sizeof(uint32_t),
+                   process_information::node_id_size);
+            m_node.reset(new process_information(process_id, node_id));
+            if (*process_information::get() == *m_node) {
+                std::cerr << "*** middleman warning: "
+                             "incoming connection from self"
+                          << std::endl;
+                return false;
             }
-            case wait_for_msg_size: {
-                //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
-                uint32_t msg_size;
-                memcpy(&msg_size, m_rd_buf.data(), sizeof(uint32_t));
-                m_rd_buf.clear();
-                m_rd_buf.final_size(msg_size);
-                m_state = read_message;
-                break;
+            CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
+            m_parent->register_peer(*m_node, this);
+            // initialization done
+            m_state = wait_for_msg_size;
+            break;
+        }
+        case wait_for_msg_size: {
+            //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
+            memcpy(&m_msg_size, frame, sizeof(uint32_t));
+            if (m_msg_size > m_rd_buf.maximum_size()) {
+                CPPA_LOGMF(CPPA_ERROR, self, "message size " << m_msg_size
+                           << " exceeds maximum of "
+                           << m_rd_buf.maximum_size() << " bytes");
+                return false;
             }
-            case read_message: {
-                //DEBUG("peer_connection::continue_reading: read_message");
-                message_header hdr;
-                any_tuple msg;
-                binary_deserializer bd(m_rd_buf.data(), m_rd_buf.size(),
-                                       m_parent->addressing(), &m_incoming_types);
-                try {
-                    m_meta_hdr->deserialize(&hdr, &bd);
-                    m_meta_msg->deserialize(&msg, &bd);
-                }
-                catch (exception& e) {
-                    CPPA_LOGMF(CPPA_ERROR, self, "exception during read_message: "
-                                   << detail::demangle(typeid(e))
-                                   << ", what(): " << e.what());
-                    return read_failure;
-                }
-                CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
-                match(msg) (
-                    // monitor messages are sent automatically whenever
-                    // actor_proxy_cache creates a new proxy
-                    // note: aid is the *original* actor id
-                    on(atom("MONITOR"), arg_match) >> [&](const process_information_ptr& node, actor_id aid) {
-                        monitor(hdr.sender, node, aid);
-                    },
-                    on(atom("KILL_PROXY"), arg_match) >> [&](const process_information_ptr& node, actor_id aid, std::uint32_t reason) {
-                        kill_proxy(hdr.sender, node, aid, reason);
-                    },
-                    on(atom("LINK"), arg_match) >> [&](const actor_ptr& ptr) {
-                        link(hdr.sender, ptr);
-                    },
-                    on(atom("UNLINK"), arg_match) >> [&](const actor_ptr& ptr) {
-                        unlink(hdr.sender, ptr);
-                    },
-                    on(atom("ADD_TYPE"), arg_match) >> [&](std::uint32_t id, const std::string& name) {
-                        auto imap = get_uniform_type_info_map();
-                        auto uti = imap->by_uniform_name(name);
-                        m_incoming_types.emplace(id, uti);
-                    },
-                    others() >> [&] {
-                        deliver(hdr, move(msg));
-                    }
-                );
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                m_state = wait_for_msg_size;
-                break;
+            m_state = read_message;
+            break;
+        }
+        case read_message: {
+            //DEBUG("peer_connection::continue_reading: read_message");
+            message_header hdr;
+            any_tuple msg;
+            binary_deserializer bd(frame, m_msg_size,
+                                   m_parent->addressing(), &m_incoming_types);
+            try {
+                m_meta_hdr->deserialize(&hdr, &bd);
+                m_meta_msg->deserialize(&msg, &bd);
             }
-            default: {
-                CPPA_CRITICAL("illegal state");
+            catch (exception& e) {
+                CPPA_LOGMF(CPPA_ERROR, self, "exception during read_message: "
+                               << detail::demangle(typeid(e))
+                               << ", what(): " << e.what());
+                return false;
             }
+            CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
+            match(msg) (
+                // monitor messages are sent automatically whenever
+                // actor_proxy_cache creates a new proxy
+                // note: aid is the *original* actor id
+                on(atom("MONITOR"), arg_match) >> [&](const process_information_ptr& node, actor_id aid) {
+                    monitor(hdr.sender, node, aid);
+                },
+                on(atom("KILL_PROXY"), arg_match) >> [&](const process_information_ptr& node, actor_id aid, std::uint32_t reason) {
+                    kill_proxy(hdr.sender, node, aid, reason);
+                },
+                on(atom("LINK"), arg_match) >> [&](const actor_ptr& ptr) {
+                    link(hdr.sender, ptr);
+                },
+                on(atom("UNLINK"), arg_match) >> [&](const actor_ptr& ptr) {
+                    unlink(hdr.sender, ptr);
+                },
+                on(atom("ADD_TYPE"), arg_match) >> [&](std::uint32_t id, const std::string& name) {
+                    auto imap = get_uniform_type_info_map();
+                    auto uti = imap->by_uniform_name(name);
+                    m_incoming_types.emplace(id, uti);
+                },
+                others() >> [&] {
+                    deliver(hdr, move(msg));
+                }
+            );
+            m_state = wait_for_msg_size;
+            break;
+        }
+        default: {
+            CPPA_CRITICAL("illegal state");
         }
-        // try to read more (next iteration)
     }
+    return true;
 }
 
 void default_peer::monitor(const actor_ptr&,
@@ -358,7 +394,7 @@ void default_peer::enqueue_impl(const message_header& hdr, const any_tuple& msg)
 
 void default_peer::enqueue(const message_header& hdr, const any_tuple& msg) {
     enqueue_impl(hdr, msg);
-    register_for_writing();
+    flush_later();
 }
 
 void default_peer::dispose() {
@@ -0,0 +1,197 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <thread>
+
+#include "cppa/config.hpp"
+
+#if defined(CPPA_LINUX) || defined(CPPA_MACOS)
+#   include <pthread.h>
+#   define CPPA_POSIX_THREADS
+#endif
+
+#include "cppa/logging.hpp"
+
+#include "cppa/detail/detached_thread_pool.hpp"
+
+namespace cppa { namespace detail {
+
+namespace {
+
+constexpr size_t default_max_idle_threads = 16;
+
+constexpr std::chrono::milliseconds default_idle_timeout{5000};
+
+typedef std::lock_guard<std::mutex> guard_type;
+
+#ifdef CPPA_POSIX_THREADS
+void* pthread_entry(void* arg) {
+    std::unique_ptr<std::function<void()>> fun{
+        static_cast<std::function<void()>*>(arg)
+    };
+    (*fun)();
+    return nullptr;
+}
+#endif
+
+} // namespace <anonymous>
+
+detached_thread_pool::detached_thread_pool() : m_state(std::make_shared<state>()) {
+    m_state->stack_size = 0;
+    m_state->max_idle = default_max_idle_threads;
+    m_state->idle_timeout = default_idle_timeout;
+    m_state->threads = 0;
+    m_state->idle = 0;
+    m_state->peak = 0;
+    m_state->created = 0;
+    m_state->shutdown = false;
+}
+
+detached_thread_pool::~detached_thread_pool() {
+    guard_type guard(m_state->mtx);
+    m_state->shutdown = true;
+    m_state->cv.notify_all();
+}
+
+void detached_thread_pool::run(job fun) {
+    guard_type guard(m_state->mtx);
+    m_state->jobs.push_back(std::move(fun));
+    // each idle thread picks up one job
+    if (m_state->idle >= m_state->jobs.size()) m_state->cv.notify_one();
+    else launch(m_state);
+}
+
+void detached_thread_pool::launch(const state_ptr& st) {
+    ++st->threads;
+    ++st->created;
+    if (st->threads > st->peak) st->peak = st->threads;
+    CPPA_LOGF_DEBUG("start detached thread, " << st->threads << " running");
+#   ifdef CPPA_POSIX_THREADS
+    if (st->stack_size > 0) {
+        auto fun = new std::function<void()>([st] { thread_loop(st); });
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+        pthread_attr_setstacksize(&attr, st->stack_size);
+        pthread_t tid;
+        auto res = pthread_create(&tid, &attr, pthread_entry, fun);
+        pthread_attr_destroy(&attr);
+        if (res == 0) return;
+        delete fun;
+        CPPA_LOGF_WARNING("unable to create thread with stack size "
+                          << st->stack_size << ", use default stack size");
+    }
+#   endif
+    try { std::thread(thread_loop, st).detach(); }
+    catch (...) {
+        --st->threads;
+        throw;
+    }
+}
+
+void detached_thread_pool::thread_loop(state_ptr st) {
+    std::unique_lock<std::mutex> guard(st->mtx);
+    for (;;) {
+        while (st->jobs.empty()) {
+            if (st->shutdown || st->idle >= st->max_idle) {
+                --st->threads;
+                return;
+            }
+            ++st->idle;
+            auto status = st->cv.wait_for(guard, st->idle_timeout);
+            --st->idle;
+            if (status == std::cv_status::timeout && st->jobs.empty()) {
+                CPPA_LOGF_DEBUG("idle detached thread exits");
+                --st->threads;
+                return;
+            }
+        }
+        auto fun = std::move(st->jobs.front());
+        st->jobs.pop_front();
+        guard.unlock();
+        fun();
+        // release the actor before this thread becomes idle
+        fun = nullptr;
+        guard.lock();
+    }
+}
+
+void detached_thread_pool::stack_size(size_t value) {
+    guard_type guard(m_state->mtx);
+    m_state->stack_size = value;
+}
+
+size_t detached_thread_pool::stack_size() const {
+    guard_type guard(m_state->mtx);
+    return m_state->stack_size;
+}
+
+void detached_thread_pool::max_idle_threads(size_t value) {
+    guard_type guard(m_state->mtx);
+    m_state->max_idle = value;
+}
+
+size_t detached_thread_pool::max_idle_threads() const {
+    guard_type guard(m_state->mtx);
+    return m_state->max_idle;
+}
+
+void detached_thread_pool::idle_timeout(std::chrono::milliseconds value) {
+    guard_type guard(m_state->mtx);
+    m_state->idle_timeout = value;
+}
+
+std::chrono::milliseconds detached_thread_pool::idle_timeout() const {
+    guard_type guard(m_state->mtx);
+    return m_state->idle_timeout;
+}
+
+size_t detached_thread_pool::num_threads() const {
+    guard_type guard(m_state->mtx);
+    return m_state->threads;
+}
+
+size_t detached_thread_pool::num_idle_threads() const {
+    guard_type guard(m_state->mtx);
+    return m_state->idle;
+}
+
+size_t detached_thread_pool::peak_threads() const {
+    guard_type guard(m_state->mtx);
+    return m_state->peak;
+}
+
+std::uint64_t detached_thread_pool::created_threads() const {
+    guard_type guard(m_state->mtx);
+    return m_state->created;
+}
+
+} } // namespace cppa::detail
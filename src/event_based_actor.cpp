@@ -28,6 +28,7 @@
 \******************************************************************************/
 
 
+#include <limits>
 #include <iostream>
 #include "cppa/to_string.hpp"
 
@@ -36,6 +37,8 @@
 #include "cppa/logging.hpp"
 #include "cppa/event_based_actor.hpp"
 
+#include "cppa/util/scope_guard.hpp"
+
 using namespace std;
 
 namespace cppa {
@@ -53,27 +56,25 @@ class default_scheduled_actor : public event_based_actor {
 
     void init() { }
 
-    resume_result resume(util::fiber* f, actor_ptr& next) {
+    resume_result resume(util::fiber* f) {
         if (!m_initialized) {
             scoped_self_setter sss{this};
             m_initialized = true;
             m_fun();
             if (m_bhvr_stack.empty()) {
                 if (exit_reason() == exit_reason::not_exited) {
-                    quit(exit_reason::normal);
-                }
-                else {
-                    set_state(actor_state::done);
-                    m_bhvr_stack.clear();
-                    m_bhvr_stack.cleanup();
-                    on_exit();
-                    next.swap(m_chained_actor);
-                    set_state(actor_state::done);
+                    // actor did not set a behavior, i.e., it is done;
+                    // cleanup also notifies linked and monitoring actors
+                    cleanup(exit_reason::normal);
                 }
+                set_state(actor_state::done);
+                m_bhvr_stack.clear();
+                m_bhvr_stack.cleanup();
+                on_exit();
                 return resume_result::actor_done;
             }
         }
-        return event_based_actor::resume(f, next);
+        return event_based_actor::resume(f);
     }
 
     scheduled_actor_type impl_type() {
@@ -91,12 +92,58 @@ intrusive_ptr<event_based_actor> event_based_actor::from(std::function<void()> f
     return make_counted<default_scheduled_actor>(std::move(fun));
 }
 
-event_based_actor::event_based_actor(actor_state st) : super(st, true) { }
+namespace {
+
+// states of event_based_actor::m_suspension
+constexpr int not_suspended = 0;
+constexpr int suspension_requested = 1;
+constexpr int suspended = 2;
+
+} // namespace <anonymous>
+
+event_based_actor::event_based_actor(actor_state st)
+: super(st), m_suspension(not_suspended)
+, m_batch_limit(0), m_batched(0) { }
+
+void event_based_actor::begin_suspension() {
+    m_suspension = suspension_requested;
+}
+
+void event_based_actor::end_suspension() {
+    // the actor is rescheduled only if it already gave up its
+    // worker, otherwise it simply continues to run
+    if (m_suspension.exchange(not_suspended) == suspended) {
+        CPPA_REQUIRE(m_scheduler != nullptr);
+        m_scheduler->enqueue(this);
+    }
+}
+
+mailbox_element* event_based_actor::dequeue_batch_element(bool (*pred)(const any_tuple&)) {
+    // skipped messages are older than any message in the mailbox and
+    // must be handled first; a pending response is handled in order
+    if (   !m_recv_policy.cache_empty()
+        || m_bhvr_stack.empty()
+        || m_bhvr_stack.back_id().valid()) {
+        return nullptr;
+    }
+    // batched messages count against the throughput budget
+    if (m_batched == m_batch_limit) return nullptr;
+    auto e = dequeue_message_if([=](const mailbox_element& e) {
+        return !e.mid.valid() && pred(e.msg);
+    });
+    if (e != nullptr) ++m_batched;
+    return e;
+}
 
-resume_result event_based_actor::resume(util::fiber*, actor_ptr& next_job) {
+bool event_based_actor::suspend() {
+    // remain in state ready, end_suspension() enqueues us
+    auto expected = suspension_requested;
+    return m_suspension.compare_exchange_strong(expected, suspended);
+}
+
+resume_result event_based_actor::resume(util::fiber*) {
     CPPA_LOG_TRACE("id = " << id() << ", state = " << static_cast<int>(state()));
-    CPPA_REQUIRE(   state() == actor_state::ready
-                 || state() == actor_state::pending);
+    CPPA_REQUIRE(state() == actor_state::ready);
     scoped_self_setter sss{this};
     auto done_cb = [&]() -> bool {
         CPPA_LOG_TRACE("");
@@ -115,19 +162,18 @@ resume_result event_based_actor::resume(util::fiber*, actor_ptr& next_job) {
         m_bhvr_stack.clear();
         m_bhvr_stack.cleanup();
         on_exit();
-        CPPA_REQUIRE(next_job == nullptr);
-        next_job.swap(m_chained_actor);
         return true;
     };
-    CPPA_REQUIRE(next_job == nullptr);
+    size_t handled = 0;
+    auto guard = util::make_scope_guard([&] {
+        add_processed_messages(handled);
+    });
     try {
         //auto e = m_mailbox.try_pop();
-        for (auto e = m_mailbox.try_pop(); ; e = m_mailbox.try_pop()) {
+        for (auto e = dequeue_message(); ; e = dequeue_message()) {
             //e = m_mailbox.try_pop();
             if (e == nullptr) {
-                CPPA_REQUIRE(next_job == nullptr);
                 CPPA_LOGMF(CPPA_DEBUG, self, "no more element in mailbox; going to block");
-                next_job.swap(m_chained_actor);
                 set_state(actor_state::about_to_block);
                 std::atomic_thread_fence(std::memory_order_seq_cst);
                 if (this->m_mailbox.can_fetch_more() == false) {
@@ -135,9 +181,6 @@ resume_result event_based_actor::resume(util::fiber*, actor_ptr& next_job) {
                                                    actor_state::blocked)) {
                         case actor_state::ready:
                             // interrupted by arriving message
-                            // restore members
-                            CPPA_REQUIRE(m_chained_actor == nullptr);
-                            next_job.swap(m_chained_actor);
                             CPPA_LOGMF(CPPA_DEBUG, self, "switched back to ready: "
                                            "interrupted by arriving message");
                             break;
@@ -154,23 +197,40 @@ resume_result event_based_actor::resume(util::fiber*, actor_ptr& next_job) {
                     CPPA_LOGMF(CPPA_DEBUG, self, "switched back to ready: "
                                    "mailbox can fetch more");
                     set_state(actor_state::ready);
-                    CPPA_REQUIRE(m_chained_actor == nullptr);
-                    next_job.swap(m_chained_actor);
                 }
             }
             else {
                 CPPA_LOGMF(CPPA_DEBUG, self, "try to invoke message: " << to_string(e->msg));
-                if (m_bhvr_stack.invoke(m_recv_policy, this, e)) {
-                    CPPA_LOG_DEBUG_IF(m_chained_actor,
-                                      "set actor with ID "
-                                      << m_chained_actor->id()
-                                      << " as successor");
+                m_batched = 0;
+                m_batch_limit = (m_max_throughput > 0)
+                              ? m_max_throughput - handled - 1
+                              : std::numeric_limits<size_t>::max();
+                auto invoked = m_bhvr_stack.invoke(m_recv_policy, this, e);
+                handled += m_batched;
+                if (invoked) {
                     if (m_bhvr_stack.empty() && done_cb()) {
                         CPPA_LOGMF(CPPA_DEBUG, self, "behavior stack empty");
+                        ++handled;
                         return resume_result::actor_done;
                     }
                     m_bhvr_stack.cleanup();
                 }
+                if (m_suspension.load() == suspension_requested) {
+                    // end_suspension() might enqueue us as soon as
+                    // suspend() returns, i.e., members are off-limits
+                    if (suspend()) {
+                        CPPA_LOGMF(CPPA_DEBUG, self, "suspended by a "
+                                   "receiver with a full mailbox");
+                        ++handled;
+                        return resume_result::actor_suspended;
+                    }
+                }
+                if (++handled >= m_max_throughput && m_max_throughput > 0) {
+                    CPPA_LOGMF(CPPA_DEBUG, self, "handled " << handled
+                               << " messages; yield to other actors");
+                    // remain in state ready, the scheduler re-enqueues us
+                    return resume_result::actor_preempted;
+                }
             }
         }
     }
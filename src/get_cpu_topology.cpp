@@ -0,0 +1,134 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <thread>
+
+#include "cppa/config.hpp"
+#include "cppa/util/get_cpu_topology.hpp"
+
+namespace {
+
+std::vector<std::vector<int>> single_node_topology() {
+    std::vector<int> cpus;
+    auto n = static_cast<int>(std::thread::hardware_concurrency());
+    for (int i = 0; i < n; ++i) cpus.push_back(i);
+    if (cpus.empty()) cpus.push_back(0);
+    return {std::move(cpus)};
+}
+
+} // namespace <anonymous>
+
+#ifdef CPPA_LINUX
+
+#include <map>
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <sched.h>
+#include <dirent.h>
+
+using namespace std;
+
+namespace cppa { namespace util {
+
+namespace {
+
+// parses lists such as "0-3,8-11"
+vector<int> parse_cpu_list(const string& str) {
+    vector<int> result;
+    const char* pos = str.c_str();
+    while (*pos != '\0' && *pos != '\n') {
+        char* end;
+        auto first = static_cast<int>(strtol(pos, &end, 10));
+        if (end == pos) break;
+        auto last = first;
+        if (*end == '-') {
+            pos = end + 1;
+            last = static_cast<int>(strtol(pos, &end, 10));
+            if (end == pos) break;
+        }
+        for (auto i = first; i <= last; ++i) result.push_back(i);
+        pos = (*end == ',') ? end + 1 : end;
+    }
+    return result;
+}
+
+} // namespace <anonymous>
+
+vector<vector<int>> get_cpu_topology() {
+    cpu_set_t available;
+    CPU_ZERO(&available);
+    if (sched_getaffinity(0, sizeof(available), &available) != 0) {
+        return single_node_topology();
+    }
+    const string node_path = "/sys/devices/system/node/";
+    auto dir = opendir(node_path.c_str());
+    if (dir == nullptr) return single_node_topology();
+    // ordered by node ID
+    map<int, vector<int>> nodes;
+    for (auto entry = readdir(dir); entry != nullptr; entry = readdir(dir)) {
+        string name = entry->d_name;
+        if (name.compare(0, 4, "node") != 0 || name.size() == 4) continue;
+        char* end;
+        auto id = static_cast<int>(strtol(name.c_str() + 4, &end, 10));
+        if (*end != '\0') continue;
+        ifstream in{node_path + name + "/cpulist"};
+        string line;
+        if (!getline(in, line)) continue;
+        vector<int> cpus;
+        for (auto cpu : parse_cpu_list(line)) {
+            if (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &available)) {
+                cpus.push_back(cpu);
+            }
+        }
+        // skip memory-only nodes and nodes outside of our cpuset
+        if (!cpus.empty()) nodes[id] = move(cpus);
+    }
+    closedir(dir);
+    if (nodes.empty()) return single_node_topology();
+    vector<vector<int>> result;
+    for (auto& kvp : nodes) result.push_back(move(kvp.second));
+    return result;
+}
+
+} } // namespace cppa::util
+
+#else // CPPA_LINUX
+
+namespace cppa { namespace util {
+
+std::vector<std::vector<int>> get_cpu_topology() {
+    return single_node_topology();
+}
+
+} } // namespace cppa::util
+
+#endif // CPPA_LINUX
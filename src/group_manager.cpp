@@ -70,10 +70,11 @@ class local_group : public group {
     void send_all_subscribers(const actor_ptr& sender, const any_tuple& msg) {
         CPPA_LOG_TRACE(CPPA_TARG(sender, to_string) << ", "
                        << CPPA_TARG(msg, to_string));
+        message_batch batch;
         shared_guard guard(m_mtx);
-        for (auto& s : m_subscribers) {
-            send_tuple_as(sender, s, msg);
-        }
+        batch.reserve(m_subscribers.size());
+        for (auto& s : m_subscribers) batch.emplace_back(s, msg);
+        send_batch_as(sender, std::move(batch));
     }
 
     void enqueue(const message_header& hdr, any_tuple msg) override {
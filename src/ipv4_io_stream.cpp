@@ -42,6 +42,7 @@
 #else
 #   include <netdb.h>
 #   include <unistd.h>
+#   include <sys/uio.h>
 #   include <sys/types.h>
 #   include <sys/socket.h>
 #   include <netinet/in.h>
@@ -112,7 +113,13 @@ void ipv4_io_stream::write(const void* vbuf, size_t len) {
 size_t ipv4_io_stream::write_some(const void* buf, size_t len) {
     auto send_result = ::send(m_fd, buf, len, 0);
     handle_write_result(send_result, true);
-    return static_cast<size_t>(send_result);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+}
+
+size_t ipv4_io_stream::write_some(const iovec* bufs, size_t num_bufs) {
+    auto writev_result = ::writev(m_fd, bufs, static_cast<int>(num_bufs));
+    handle_write_result(writev_result, true);
+    return (writev_result > 0) ? static_cast<size_t>(writev_result) : 0;
 }
 
 io::stream_ptr ipv4_io_stream::from_native_socket(native_socket_type fd) {
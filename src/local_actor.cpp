@@ -74,9 +74,8 @@ constexpr const char* s_default_debug_name = "actor";
 
 } // namespace <anonymous>
 
-local_actor::local_actor(bool sflag)
-: m_chaining(sflag), m_trap_exit(false)
-, m_is_scheduled(sflag), m_dummy_node(), m_current_node(&m_dummy_node)
+local_actor::local_actor()
+: m_trap_exit(false), m_dummy_node(), m_current_node(&m_dummy_node)
 , m_planned_exit_reason(exit_reason::not_exited) {
 #   ifdef CPPA_DEBUG_MODE
     new (&m_debug_name) std::string (std::to_string(m_id) + "@local");
@@ -120,6 +119,10 @@ void local_actor::on_exit() { }
 
 void local_actor::init() { }
 
+mailbox_element* local_actor::dequeue_batch_element(bool (*)(const any_tuple&)) {
+    return nullptr;
+}
+
 void local_actor::join(const group_ptr& what) {
     if (what && m_subscriptions.count(what) == 0) {
         m_subscriptions.insert(std::make_pair(what, what->subscribe(this)));
@@ -148,12 +151,7 @@ void local_actor::reply_message(any_tuple&& what) {
         send_tuple(whom, std::move(what));
     }
     else if (!id.is_answered()) {
-        if (chaining_enabled()) {
-            if (whom->chained_enqueue({this, whom, id.response_id()}, std::move(what))) {
-                chained_actor(whom);
-            }
-        }
-        else whom->enqueue({this, whom, id.response_id()}, std::move(what));
+        whom->enqueue({this, whom, id.response_id()}, std::move(what));
         id.mark_as_answered();
     }
 }
@@ -161,6 +159,7 @@ void local_actor::reply_message(any_tuple&& what) {
 void local_actor::forward_message(const actor_ptr& dest, message_priority p) {
     if (dest == nullptr) return;
     auto& id = m_current_node->mid;
+    m_current_node->move_msg_to_heap();
     dest->enqueue({last_sender(), dest, id, p}, m_current_node->msg);
     // treat this message as asynchronous message from now on
     id = message_id{};
@@ -32,7 +32,78 @@
 
 namespace cppa {
 
+mailbox_element::mailbox_element() : m_parts(0), m_unclaimed(false) { }
+
 mailbox_element::mailbox_element(const message_header& hdr, any_tuple data)
-: next(nullptr), marked(false), sender(hdr.sender), msg(std::move(data)), mid(hdr.id) { }
+: next(nullptr), marked(false), sender(hdr.sender), msg(std::move(data))
+, mid(hdr.id), m_parts(0), m_unclaimed(false) {
+    // fallback for tuples that were not created by make_embedded():
+    // move small messages we own exclusively into our own memory,
+    // the heap object is released before the receiver ever touches it
+    auto& cvals = msg.cvals();
+    if (inline_size > 0 && cvals && cvals->unique()) {
+        auto ptr = msg.vals()->move_to(&m_storage, inline_size, this);
+        if (ptr) {
+            m_parts = 2;
+            msg = any_tuple{ptr};
+        }
+    }
+}
+
+mailbox_element* mailbox_element::create(const message_header& hdr,
+                                         any_tuple data) {
+    auto vals = data.cvals().get();
+    auto owner = vals ? vals->embedded_in() : nullptr;
+    // a shared tuple must remain where it is
+    auto e = owner && vals->unique() ? owner->claim_element() : nullptr;
+    if (e == nullptr) {
+        return detail::memory::create<mailbox_element>(hdr, std::move(data));
+    }
+    e->next = nullptr;
+    e->marked = false;
+    e->sender = hdr.sender;
+    e->msg = std::move(data);
+    e->mid = hdr.id;
+    e->m_parts = 2;
+    return e;
+}
+
+void mailbox_element::move_msg_to_heap() {
+    if (embeds(msg.cvals().get())) {
+        // releases the embedded tuple unless it is already shared
+        msg = any_tuple{msg.cvals()->copy()};
+    }
+}
+
+void mailbox_element::request_deletion() {
+    if (m_parts == 0) super::request_deletion();
+    else {
+        // the embedded tuple calls release_embedded() after it was
+        // released by all references that were not moved to the heap,
+        // e.g., tuple views created during pattern matching
+        msg.reset();
+        release_part();
+    }
+}
+
+void mailbox_element::release_embedded() {
+    release_part();
+}
+
+mailbox_element* mailbox_element::claim_element() {
+    if (!m_unclaimed) return nullptr;
+    m_unclaimed = false;
+    return this;
+}
+
+void mailbox_element::release_part() {
+    if (--m_parts == 0) super::request_deletion();
+}
+
+bool mailbox_element::embeds(const void* ptr) const {
+    auto first = reinterpret_cast<const char*>(&m_storage);
+    auto p = reinterpret_cast<const char*>(ptr);
+    return p >= first && p < first + sizeof(m_storage);
+}
 
 } // namespace cppa
@@ -28,19 +28,60 @@
 \******************************************************************************/
 
 
+#include <atomic>
 #include <vector>
-#include <typeinfo>
+#include <algorithm>
 
 #include "cppa/detail/memory.hpp"
-#include "cppa/mailbox_element.hpp"
 
 using namespace std;
 
+namespace cppa { namespace detail {
+
+namespace {
+
+memory_settings& global_settings() {
+    static memory_settings s_settings;
+    return s_settings;
+}
+
+} // namespace <anonymous>
+
+memory_settings::memory_settings()
+: alloc_size(1024*1024), cache_size(10*1024*1024)
+, size_classes{32, 64, 128, 256, 512} { }
+
+void memory::configure(memory_settings settings) {
+    sort(settings.size_classes.begin(), settings.size_classes.end());
+    global_settings() = move(settings);
+}
+
+const memory_settings& memory::settings() {
+    return global_settings();
+}
+
+memory_counters::memory_counters()
+: instances(0), blocks(0), chunks(0), returned(0) { }
+
+memory_counters& memory_counters::operator+=(const memory_counters& other) {
+    instances += other.instances;
+    blocks += other.blocks;
+    chunks += other.chunks;
+    returned += other.returned;
+    return *this;
+}
+
 #ifdef CPPA_DISABLE_MEM_MANAGEMENT
 
-int cppa_memory_keep_compiler_happy() { return 0; }
+memory_counters memory::thread_counters() {
+    return {};
+}
+
+#endif // CPPA_DISABLE_MEM_MANAGEMENT
+
+} } // namespace cppa::detail
 
-#else // CPPA_DISABLE_MEM_MANAGEMENT
+#ifndef CPPA_DISABLE_MEM_MANAGEMENT
 
 namespace cppa { namespace detail {
 
@@ -49,43 +90,233 @@ namespace {
 pthread_key_t s_key;
 pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
 
+class slab_chunk;
+
+// header of each block, followed by the payload
+struct slab_block {
+    slab_chunk* chunk;
+    slab_block* next; // links blocks returned to the owning slab
+    void deallocate();
+};
+
+// payloads start at a 16 byte boundary
+constexpr size_t s_block_header = (sizeof(slab_block) + 15) & ~size_t{15};
+
+typedef returned_list<slab_block> slab_list;
+
+// a chunk of equally sized blocks, each block holds a reference to its chunk
+class slab_chunk : public ref_counted {
+
+ public:
+
+    static slab_chunk* create(slab_list* owner, size_t block_size, size_t num) {
+        auto mem = ::operator new(header_size() + block_size * num);
+        return new (mem) slab_chunk(owner, block_size, num);
+    }
+
+    inline slab_list* owner() const { return m_owner; }
+
+    template<typename F>
+    void for_each_block(F fun) {
+        auto first = reinterpret_cast<char*>(this) + header_size();
+        for (size_t i = 0; i < m_num_blocks; ++i) {
+            fun(reinterpret_cast<slab_block*>(first + i * m_block_size));
+        }
+    }
+
+ protected:
+
+    void request_deletion() {
+        this->~slab_chunk();
+        ::operator delete(this);
+    }
+
+ private:
+
+    slab_chunk(slab_list* owner, size_t block_size, size_t num)
+    : m_owner(owner), m_block_size(block_size), m_num_blocks(num) {
+        m_owner->ref();
+        for_each_block([&](slab_block* block) {
+            block->chunk = this;
+            block->next = nullptr;
+            ref(); // deref() is called in slab_block::deallocate
+        });
+    }
+
+    ~slab_chunk() {
+        m_owner->deref();
+    }
+
+    static constexpr size_t header_size() {
+        return (sizeof(slab_chunk) + 15) & ~size_t{15};
+    }
+
+    slab_list* m_owner;
+    size_t m_block_size;
+    size_t m_num_blocks;
+
+};
+
+void slab_block::deallocate() {
+    chunk->deref();
+}
+
+// caches blocks of one size class for a single thread
+class slab_class {
+
+ public:
+
+    slab_class(size_t size, const memory_settings& cfg)
+    : m_size(size), m_block_size(s_block_header + ((size + 15) & ~size_t{15}))
+    , m_blocks_per_chunk(max(cfg.alloc_size / m_block_size, s_min_elements))
+    , m_max_cached(cfg.cache_size / m_block_size), m_returned(new slab_list) {
+        m_returned->ref();
+    }
+
+    ~slab_class() {
+        m_returned->close();
+        for (auto b : m_cached) b->deallocate();
+        m_returned->deref();
+    }
+
+    inline size_t size() const { return m_size; }
+
+    inline const memory_counters& counters() const { return m_counters; }
+
+    void* allocate() {
+        ++m_counters.blocks;
+        if (m_cached.empty()) fetch_returned();
+        if (m_cached.empty()) allocate_chunk();
+        auto block = m_cached.back();
+        m_cached.pop_back();
+        return reinterpret_cast<char*>(block) + s_block_header;
+    }
+
+    void deallocate(void* ptr) {
+        auto block = reinterpret_cast<slab_block*>(  static_cast<char*>(ptr)
+                                                   - s_block_header);
+        auto owner = block->chunk->owner();
+        if (owner != m_returned) m_batches.add(owner, block);
+        else if (m_cached.size() < m_max_cached) m_cached.push_back(block);
+        else block->deallocate();
+    }
+
+ private:
+
+    void allocate_chunk() {
+        ++m_counters.chunks;
+        auto chunk = slab_chunk::create(m_returned,
+                                        m_block_size,
+                                        m_blocks_per_chunk);
+        chunk->for_each_block([&](slab_block* block) {
+            m_cached.push_back(block);
+        });
+    }
+
+    void fetch_returned() {
+        for (auto b = m_returned->take_all(); b != nullptr; b = b->next) {
+            m_cached.push_back(b);
+            ++m_counters.returned;
+        }
+    }
+
+    size_t m_size;
+    size_t m_block_size;
+    size_t m_blocks_per_chunk;
+    size_t m_max_cached;
+    vector<slab_block*> m_cached;
+    slab_list* m_returned;
+    returned_batches<slab_block> m_batches;
+    memory_counters m_counters;
+
+};
+
+struct thread_caches {
+    vector<unique_ptr<memory_cache> > types; // indexed by cache slot
+    vector<unique_ptr<slab_class> > slabs;
+    memory_counters large; // blocks exceeding all size classes
+};
+
+atomic<size_t> s_next_cache_slot{0};
+
+// the pthread key only destroys the caches on thread exit,
+// lookups use the cheaper thread-local pointer
+__thread thread_caches* t_caches = nullptr;
+
+void thread_caches_destructor(void* ptr) {
+    t_caches = nullptr;
+    if (ptr) delete reinterpret_cast<thread_caches*>(ptr);
+}
+
+void make_thread_caches_key() {
+    pthread_key_create(&s_key, thread_caches_destructor);
+}
+
+thread_caches& get_thread_caches() {
+    if (t_caches) return *t_caches;
+    pthread_once(&s_key_once, make_thread_caches_key);
+    auto caches = new thread_caches;
+    pthread_setspecific(s_key, caches);
+    t_caches = caches;
+    auto& cfg = memory::settings();
+    caches->slabs.reserve(cfg.size_classes.size());
+    for (auto size : cfg.size_classes) {
+        caches->slabs.emplace_back(new slab_class(size, cfg));
+    }
+    return *caches;
+}
+
+// returns the smallest size class for @p size or nullptr
+slab_class* get_slab_class(size_t size) {
+    for (auto& sc : get_thread_caches().slabs) {
+        if (sc->size() >= size) return sc.get();
+    }
+    return nullptr;
+}
+
 } // namespace <anonymous>
 
 memory_cache::~memory_cache() { }
 
-typedef map<const type_info*, unique_ptr<memory_cache> > cache_map;
+size_t memory::next_cache_slot() {
+    return s_next_cache_slot++;
+}
 
-void cache_map_destructor(void* ptr) {
-    if (ptr) delete reinterpret_cast<cache_map*>(ptr);
+memory_cache* memory::get_cache_slot(size_t slot) {
+    auto& types = get_thread_caches().types;
+    return slot < types.size() ? types[slot].get() : nullptr;
 }
 
-void make_cache_map() {
-    pthread_key_create(&s_key, cache_map_destructor);
+void memory::set_cache_slot(size_t slot, memory_cache* instance) {
+    auto& types = get_thread_caches().types;
+    if (slot >= types.size()) types.resize(slot + 1);
+    types[slot].reset(instance);
 }
 
-cache_map& get_cache_map() {
-    pthread_once(&s_key_once, make_cache_map);
-    auto cache = reinterpret_cast<cache_map*>(pthread_getspecific(s_key));
-    if (!cache) {
-        cache = new cache_map;
-        pthread_setspecific(s_key, cache);
-        // insert default types
-        unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-        cache->insert(make_pair(&typeid(mailbox_element), move(tmp)));
+memory_counters memory::thread_counters() {
+    memory_counters result;
+    auto& caches = get_thread_caches();
+    for (auto& mc : caches.types) {
+        if (mc) result += mc->counters;
     }
-    return *cache;
+    for (auto& sc : caches.slabs) result += sc->counters();
+    result += caches.large;
+    return result;
 }
 
-memory_cache* memory::get_cache_map_entry(const type_info* tinf) {
-    auto& cache = get_cache_map();
-    auto i = cache.find(tinf);
-    if (i != cache.end()) return i->second.get();
-    return nullptr;
+void* memory::allocate(size_t size) {
+    auto sc = get_slab_class(size);
+    if (sc) return sc->allocate();
+    auto& large = get_thread_caches().large;
+    ++large.blocks;
+    ++large.chunks;
+    return ::operator new(size);
 }
 
-void memory::add_cache_map_entry(const type_info* tinf, memory_cache* instance) {
-    auto& cache = get_cache_map();
-    cache[tinf].reset(instance);
+void memory::deallocate(void* ptr, size_t size) {
+    auto sc = get_slab_class(size);
+    if (sc) sc->deallocate(ptr);
+    else ::operator delete(ptr);
 }
 
 instance_wrapper::~instance_wrapper() { }
@@ -28,7 +28,9 @@
 \******************************************************************************/
 
 
+#include <map>
 #include <tuple>
+#include <chrono>
 #include <cerrno>
 #include <memory>
 #include <cstring>
@@ -93,6 +95,8 @@ class middleman_impl {
     friend class middleman;
     friend void middleman_loop(middleman_impl*);
 
+    typedef multimap<chrono::steady_clock::time_point, continuable*> timer_map;
+
  public:
 
     middleman_impl(std::unique_ptr<protocol>&& proto)
@@ -140,6 +144,43 @@ class middleman_impl {
         return m_handler->has_reader(ptr);
     }
 
+    void continue_writer_at(continuable* ptr, timer_map::key_type deadline) {
+        CPPA_LOG_TRACE(CPPA_ARG(ptr));
+        m_timers.emplace(deadline, ptr);
+    }
+
+    void cancel_continue_writer_at(continuable* ptr) {
+        CPPA_LOG_TRACE(CPPA_ARG(ptr));
+        for (auto i = m_timers.begin(); i != m_timers.end(); ) {
+            if (i->second == ptr) i = m_timers.erase(i);
+            else ++i;
+        }
+    }
+
+    // returns the poll timeout in milliseconds until the next deadline
+    int poll_timeout() const {
+        if (m_timers.empty()) return -1;
+        using namespace std::chrono;
+        auto now = steady_clock::now();
+        auto deadline = m_timers.begin()->first;
+        if (deadline <= now) return 0;
+        // round up to make sure the deadline has passed after poll()
+        auto ms = duration_cast<milliseconds>(deadline - now) + milliseconds(1);
+        return static_cast<int>(ms.count());
+    }
+
+    // adds all writers with passed deadlines; all writers if force is set
+    void handle_timers(bool force = false) {
+        if (m_timers.empty()) return;
+        auto now = chrono::steady_clock::now();
+        auto i = m_timers.begin();
+        while (i != m_timers.end() && (force || i->first <= now)) {
+            continue_writer(i->second);
+            i = m_timers.erase(i);
+        }
+        m_handler->update();
+    }
+
  protected:
 
     void initialize() {
@@ -177,6 +218,7 @@ class middleman_impl {
     native_socket_type m_pipe_write;
     middleman_queue m_queue;
     std::unique_ptr<middleman_event_handler> m_handler;
+    timer_map m_timers;
 
     std::unique_ptr<protocol> m_protocol;
 
@@ -209,28 +251,34 @@ class middleman_overseer : public continuable {
         CPPA_LOG_TRACE("");
         static constexpr size_t num_dummies = 64;
         uint8_t dummies[num_dummies];
-        auto read_result = ::read(read_handle(), dummies, num_dummies);
-        CPPA_LOGMF(CPPA_DEBUG, self, "read " << read_result << " messages from queue");
-        if (read_result < 0) {
-            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // try again later
-                return read_continue_later;
+        // read until the pipe is empty, because an edge-triggered
+        // event handler won't report remaining bytes again
+        for (;;) {
+            auto read_result = ::read(read_handle(), dummies, num_dummies);
+            CPPA_LOGMF(CPPA_DEBUG, self, "read " << read_result << " messages from queue");
+            if (read_result < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    // try again later
+                    return read_continue_later;
+                }
+                else {
+                    CPPA_LOGMF(CPPA_ERROR, self, "cannot read from pipe");
+                    CPPA_CRITICAL("cannot read from pipe");
+                }
             }
-            else {
-                CPPA_LOGMF(CPPA_ERROR, self, "cannot read from pipe");
-                CPPA_CRITICAL("cannot read from pipe");
+            for (int i = 0; i < read_result; ++i) {
+                unique_ptr<middleman_event> msg(m_queue.try_pop());
+                if (!msg) {
+                    CPPA_LOGMF(CPPA_ERROR, self, "nullptr dequeued");
+                    CPPA_CRITICAL("nullptr dequeued");
+                }
+                CPPA_LOGF_DEBUG("execute run_later functor");
+                (*msg)();
             }
-        }
-        for (int i = 0; i < read_result; ++i) {
-            unique_ptr<middleman_event> msg(m_queue.try_pop());
-            if (!msg) {
-                CPPA_LOGMF(CPPA_ERROR, self, "nullptr dequeued");
-                CPPA_CRITICAL("nullptr dequeued");
+            if (static_cast<size_t>(read_result) < num_dummies) {
+                return read_continue_later;
             }
-            CPPA_LOGF_DEBUG("execute run_later functor");
-            (*msg)();
         }
-        return read_continue_later;
     }
 
     void io_failed(event_bitmask) override {
@@ -285,6 +333,15 @@ bool middleman::has_reader(continuable* ptr) {
     return m_impl->has_reader(ptr);
 }
 
+void middleman::continue_writer_at(continuable* ptr,
+                                   chrono::steady_clock::time_point deadline) {
+    m_impl->continue_writer_at(ptr, deadline);
+}
+
+void middleman::cancel_continue_writer_at(continuable* ptr) {
+    m_impl->cancel_continue_writer_at(ptr);
+}
+
 
 void middleman_loop(middleman_impl* impl) {
 #   ifdef CPPA_LOG_LEVEL
@@ -300,7 +357,8 @@ void middleman_loop(middleman_impl* impl) {
     impl->continue_reader(new middleman_overseer(impl->m_pipe_read, impl->m_queue));
     handler->update();
     while (!impl->done()) {
-        handler->poll([&](event_bitmask mask, continuable* io) {
+        auto timeout = impl->poll_timeout();
+        handler->poll(timeout, [&](event_bitmask mask, continuable* io) {
             switch (mask) {
                 default: CPPA_CRITICAL("invalid event");
                 case event::none: break;
@@ -347,8 +405,11 @@ void middleman_loop(middleman_impl* impl) {
                 }
             }
         });
+        impl->handle_timers();
     }
     CPPA_LOGF_DEBUG("event loop done, erase all readers");
+    // write held back data as well
+    impl->handle_timers(true);
     // make sure to write everything before shutting down
     handler->for_each_reader([handler](continuable* ptr) {
         handler->erase_later(ptr, event::read);
@@ -358,7 +419,7 @@ void middleman_loop(middleman_impl* impl) {
     CPPA_LOGF_DEBUG_IF(handler->num_sockets() == 0,
                        "nothing to flush, no writer left");
     while (handler->num_sockets() > 0) {
-        handler->poll([&](event_bitmask mask, continuable* io) {
+        handler->poll(-1, [&](event_bitmask mask, continuable* io) {
             switch (mask) {
                 case event::write:
                     switch (io->continue_writing()) {
@@ -394,6 +455,10 @@ namespace {
 
 std::atomic<size_t> default_max_msg_size{16 * 1024 * 1024};
 
+std::atomic<std::int64_t> default_flush_delay{0};
+
+std::atomic<size_t> default_flush_threshold{64 * 1024};
+
 } // namespace <anonymous>
 
 void max_msg_size(size_t size)
@@ -406,4 +471,20 @@ size_t max_msg_size()
   return default_max_msg_size;
 }
 
+void flush_delay(std::chrono::microseconds delay) {
+    default_flush_delay = delay.count();
+}
+
+std::chrono::microseconds flush_delay() {
+    return std::chrono::microseconds(default_flush_delay.load());
+}
+
+void flush_threshold(size_t num_bytes) {
+    default_flush_threshold = num_bytes;
+}
+
+size_t flush_threshold() {
+    return default_flush_threshold;
+}
+
 } // namespace cppa
@@ -100,40 +100,69 @@ void middleman_event_handler::update() {
     auto mless = [](const fd_meta_info& lhs, native_socket_type rhs) {
         return lhs.fd < rhs;
     };
+    // collect the net change per file descriptor first to
+    // call handle_event() at most once per file descriptor
     for (auto& elem_pair : m_alterations) {
         auto& elem = elem_pair.first;
         auto old = event::none;
+        continuable* old_ptr = nullptr;
         auto last = m_meta.end();
         auto iter = std::lower_bound(m_meta.begin(), last, elem.fd, mless);
-        if (iter != last) old = iter->mask;
+        if (iter != last && iter->fd == elem.fd) {
+            old = iter->mask;
+            old_ptr = iter->ptr;
+        }
         auto mask = next_bitmask(old, elem.mask, elem_pair.second);
         auto ptr = elem.ptr;
         CPPA_LOG_DEBUG("new bitmask for "
                        << elem.ptr << ": " << eb2str(mask));
+        auto c = std::find_if(m_changes.begin(), m_changes.end(),
+                              [&](const fd_change& x) {
+                                  return x.fd == elem.fd;
+                              });
+        if (c == m_changes.end()) {
+            m_changes.push_back(fd_change{elem.fd, old_ptr, old, ptr, mask});
+        }
+        else {
+            c->ptr = ptr;
+            c->mask = mask;
+        }
         if (iter == last || iter->fd != elem.fd) {
             CPPA_LOG_ERROR_IF(mask == event::none,
                               "cannot erase " << ptr << " (no such element)");
-            if (mask != event::none) {
-                m_meta.insert(iter, elem);
-                handle_event(fd_meta_event::add, elem.fd,
-                             event::none, mask, ptr);
-            }
+            if (mask != event::none) m_meta.insert(iter, elem);
         }
-        else if (iter->fd == elem.fd) {
+        else {
             CPPA_REQUIRE(iter->ptr == elem.ptr);
             if (mask == event::none) {
                 // note: we cannot decide whether it's safe to dispose `ptr`,
                 // because we didn't parse all alterations yet
                 m_dispose_list.emplace_back(ptr);
                 m_meta.erase(iter);
-                handle_event(fd_meta_event::erase, elem.fd, old, mask, ptr);
-            }
-            else {
-                iter->mask = mask;
-                handle_event(fd_meta_event::mod, elem.fd, old, mask, ptr);
             }
+            else iter->mask = mask;
         }
     }
+    for (auto& c : m_changes) {
+        if (c.old_mask == c.mask && c.old_ptr == c.ptr) continue;
+        if (c.old_mask == event::none) {
+            handle_event(fd_meta_event::add, c.fd, event::none, c.mask, c.ptr);
+        }
+        else if (c.mask == event::none) {
+            handle_event(fd_meta_event::erase, c.fd,
+                         c.old_mask, event::none, c.old_ptr);
+        }
+        else if (c.old_ptr != c.ptr) {
+            // file descriptor was closed and reused within this update
+            handle_event(fd_meta_event::erase, c.fd,
+                         c.old_mask, event::none, c.old_ptr);
+            handle_event(fd_meta_event::add, c.fd, event::none, c.mask, c.ptr);
+        }
+        else {
+            handle_event(fd_meta_event::mod, c.fd, c.old_mask, c.mask, c.ptr);
+        }
+    }
+    m_changes.clear();
     m_alterations.clear();
     // m_meta won't be touched inside loop
     auto first = m_meta.begin();
@@ -154,6 +183,16 @@ void middleman_event_handler::update() {
     m_dispose_list.clear();
 }
 
+const fd_meta_info* middleman_event_handler::meta_of(native_socket_type fd) const {
+    auto last = m_meta.end();
+    auto iter = std::lower_bound(m_meta.begin(), last, fd,
+                                 [](const fd_meta_info& lhs,
+                                    native_socket_type rhs) {
+                                     return lhs.fd < rhs;
+                                 });
+    return (iter != last && iter->fd == fd) ? &*iter : nullptr;
+}
+
 bool middleman_event_handler::has_reader(continuable* ptr) {
     return std::any_of(m_meta.begin(), m_meta.end(), [=](fd_meta_info& meta) {
         return meta.ptr == ptr && (meta.mask & event::read);
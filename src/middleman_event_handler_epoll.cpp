@@ -35,6 +35,7 @@
 #include <ios>
 #include <string>
 #include <vector>
+#include <algorithm>
 
 #include <string.h>
 #include <sys/epoll.h>
@@ -49,6 +50,15 @@ static constexpr unsigned input_event  = EPOLLIN;
 static constexpr unsigned error_event  = EPOLLRDHUP | EPOLLERR | EPOLLHUP;
 static constexpr unsigned output_event = EPOLLOUT;
 
+// in edge-triggered mode, each file descriptor is registered once for
+// reading and writing, i.e., add_later() and erase_later() do not cause
+// any epoll_ctl calls as long as the file descriptor remains in use
+#ifdef CPPA_EPOLL_EDGE_TRIGGERED
+static constexpr bool edge_triggered = true;
+#else
+static constexpr bool edge_triggered = false;
+#endif
+
 class middleman_event_handler_impl : public middleman_event_handler {
 
  public:
@@ -63,20 +73,22 @@ class middleman_event_handler_impl : public middleman_event_handler {
             throw std::ios_base::failure(  std::string("epoll_create1: ")
                                          + strerror(errno));
         }
-        // handle at most 64 events at a time
+        // handle at most 64 events at a time, grows if needed
         m_epollset.resize(64);
     }
 
  protected:
 
-    void poll_impl() {
+    void poll_impl(int timeout) {
         CPPA_REQUIRE(m_meta.empty() == false);
+        // don't block if we have to deliver events that epoll won't report
+        if (!m_ready.empty()) timeout = 0;
         int presult = -1;
         while (presult < 0) {
             presult = epoll_wait(m_epollfd,
                                  m_epollset.data(),
                                  static_cast<int>(m_epollset.size()),
-                                 -1);
+                                 timeout);
             CPPA_LOG_DEBUG("epoll_wait on " << num_sockets()
                            << " sockets returned " << presult);
             if (presult < 0) {
@@ -96,37 +108,79 @@ class middleman_event_handler_impl : public middleman_event_handler {
         auto iter = m_epollset.begin();
         auto last = iter + static_cast<size_t>(presult);
         for ( ; iter != last; ++iter) {
+            auto meta = meta_of(iter->data.fd);
+            if (meta == nullptr) continue;
+            // drop events nobody is interested in (edge-triggered mode)
+            auto events = iter->events;
+            if (!(meta->mask & event::read)) events &= ~static_cast<unsigned>(EPOLLIN | EPOLLRDHUP);
+            if (!(meta->mask & event::write)) events &= ~static_cast<unsigned>(EPOLLOUT);
             auto eb = from_int_bitmask<input_event,
                                        output_event,
-                                       error_event>(iter->events);
-            auto ptr = reinterpret_cast<continuable*>(iter->data.ptr);
-            CPPA_REQUIRE(eb != event::none);
-            m_events.emplace_back(eb, ptr);
+                                       error_event>(events);
+            if (eb != event::none) m_events.emplace_back(eb, meta->ptr);
+        }
+        for (auto& r : m_ready) {
+            auto meta = meta_of(r.first);
+            if (meta == nullptr) continue;
+            auto eb = r.second & meta->mask;
+            if (eb == event::none) continue;
+            auto i = std::find_if(m_events.begin(), m_events.end(),
+                                  [&](const std::pair<event_bitmask, continuable*>& e) {
+                                      return e.second == meta->ptr;
+                                  });
+            if (i == m_events.end()) m_events.emplace_back(eb, meta->ptr);
+            else if (i->first != event::error) i->first |= eb;
+        }
+        m_ready.clear();
+        // grow the event array if epoll had more events to report
+        if (static_cast<size_t>(presult) == m_epollset.size()) {
+            m_epollset.resize(m_epollset.size() * 2);
         }
     }
 
     void handle_event(fd_meta_event me,
                       native_socket_type fd,
-                      event_bitmask,
+                      event_bitmask old_bitmask,
                       event_bitmask new_bitmask,
-                      continuable* ptr) {
+                      continuable*) {
         int operation;
         epoll_event ee;
-        ee.data.ptr = ptr;
-        switch (new_bitmask) {
-            case event::none:
-                CPPA_REQUIRE(me == fd_meta_event::erase);
-                ee.events = 0;
-                break;
-            case event::read:
-                ee.events = EPOLLIN | EPOLLRDHUP;
-                break;
-            case event::write:
-                ee.events = EPOLLOUT;
-            case event::both:
-                ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
-                break;
-            default: CPPA_CRITICAL("invalid event bitmask");
+        ee.data.fd = fd;
+        if (edge_triggered) {
+            // epoll reports no edge for a file descriptor that already
+            // was ready before, hence we report new interests ourselves
+            // once; a newly added file descriptor is reported by epoll
+            if (me == fd_meta_event::mod) {
+                auto added = new_bitmask & ~old_bitmask;
+                if (added != event::none) m_ready.emplace_back(fd, added);
+                return;
+            }
+            if (me == fd_meta_event::erase) {
+                m_ready.erase(std::remove_if(m_ready.begin(), m_ready.end(),
+                                             [=](const ready_entry& r) {
+                                                 return r.first == fd;
+                                             }),
+                              m_ready.end());
+            }
+            ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT | EPOLLET;
+        }
+        else {
+            switch (new_bitmask) {
+                case event::none:
+                    CPPA_REQUIRE(me == fd_meta_event::erase);
+                    ee.events = 0;
+                    break;
+                case event::read:
+                    ee.events = EPOLLIN | EPOLLRDHUP;
+                    break;
+                case event::write:
+                    ee.events = EPOLLOUT;
+                    break;
+                case event::both:
+                    ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+                    break;
+                default: CPPA_CRITICAL("invalid event bitmask");
+            }
         }
         switch (me) {
             case fd_meta_event::add:
@@ -165,9 +219,14 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
  private:
 
+    typedef std::pair<native_socket_type, event_bitmask> ready_entry;
+
     int m_epollfd;
     std::vector<epoll_event> m_epollset;
 
+    // events epoll won't report in edge-triggered mode
+    std::vector<ready_entry> m_ready;
+
 };
 
 } // namespace <anonymous>
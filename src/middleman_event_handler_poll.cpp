@@ -68,12 +68,12 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
  protected:
 
-    void poll_impl() {
+    void poll_impl(int timeout) {
         CPPA_REQUIRE(m_pollset.empty() == false);
         CPPA_REQUIRE(m_pollset.size() == m_meta.size());
         int presult = -1;
         while (presult < 0) {
-            presult = ::poll(m_pollset.data(), m_pollset.size(), -1);
+            presult = ::poll(m_pollset.data(), m_pollset.size(), timeout);
             CPPA_LOG_DEBUG("poll() on " << num_sockets()
                            << " sockets returned " << presult);
             if (presult < 0) {
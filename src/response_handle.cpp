@@ -54,16 +54,7 @@ bool response_handle::synchronous() const {
 }
 
 void response_handle::apply(any_tuple msg) const {
-    if (valid()) {
-        local_actor* sptr = self.unchecked();
-        bool use_chaining = sptr && sptr == m_from && sptr->chaining_enabled();
-        if (use_chaining) {
-            if (m_to->chained_enqueue({m_from, m_to, m_id}, move(msg))) {
-                sptr->chained_actor(m_to);
-            }
-        }
-        else m_to->enqueue({m_from, m_to, m_id}, move(msg));
-    }
+    if (valid()) m_to->enqueue({m_from, m_to, m_id}, move(msg));
 }
 
 } // namespace cppa
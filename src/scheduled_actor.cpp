@@ -36,9 +36,17 @@
 
 namespace cppa {
 
-scheduled_actor::scheduled_actor(actor_state init_state, bool chained_send)
-: super(chained_send), next(nullptr), m_state(init_state)
-, m_scheduler(nullptr), m_hidden(false) { }
+namespace {
+
+// read by the scheduler's workers after resuming an actor
+__thread std::uint64_t t_processed_messages = 0;
+
+} // namespace <anonymous>
+
+scheduled_actor::scheduled_actor(actor_state init_state)
+: next(nullptr), m_state(init_state)
+, m_scheduler(nullptr), m_hidden(false), m_max_throughput(0)
+, m_priority(scheduling_priority::normal) { }
 
 void scheduled_actor::attach_to_scheduler(scheduler* sched, bool hidden) {
     CPPA_REQUIRE(sched != nullptr);
@@ -50,10 +58,16 @@ void scheduled_actor::attach_to_scheduler(scheduler* sched, bool hidden) {
     // initialize this actor
     try { init(); }
     catch (...) { }
-    // check whether init() did send a chained message
-    actor_ptr ca;
-    ca.swap(m_chained_actor);
-    if (ca) ca->unchain();
+}
+
+std::uint64_t scheduled_actor::fetch_processed_messages() {
+    auto result = t_processed_messages;
+    t_processed_messages = 0;
+    return result;
+}
+
+void scheduled_actor::add_processed_messages(size_t num) {
+    t_processed_messages += num;
 }
 
 bool scheduled_actor::initialized() const {
@@ -61,10 +75,7 @@ bool scheduled_actor::initialized() const {
 }
 
 scheduled_actor::~scheduled_actor() {
-    if (!m_mailbox.closed()) {
-        detail::sync_request_bouncer f{exit_reason()};
-        m_mailbox.close(f);
-    }
+    // mailbox_based closes the mailbox if cleanup() was never called
 }
 
 void scheduled_actor::run_detached() {
@@ -77,21 +88,20 @@ void scheduled_actor::cleanup(std::uint32_t reason) {
     super::cleanup(reason);
 }
 
-bool scheduled_actor::enqueue_impl(actor_state next_state,
+bool scheduled_actor::enqueue_impl(bool schedule,
                                    const message_header& hdr,
                                    any_tuple&& msg) {
-    CPPA_REQUIRE(   next_state == actor_state::ready
-                 || next_state == actor_state::pending);
+    if (!admit_message(hdr)) return false;
     auto e = new_mailbox_element(hdr, std::move(msg));
-    switch (m_mailbox.enqueue(e)) {
+    switch (enqueue_message(m_mailbox, e)) {
         case intrusive::first_enqueued: {
             auto state = m_state.load();
             for (;;) {
                 switch (state) {
                     case actor_state::blocked: {
-                        if (m_state.compare_exchange_weak(state, next_state)) {
+                        if (m_state.compare_exchange_weak(state, actor_state::ready)) {
                             CPPA_REQUIRE(m_scheduler != nullptr);
-                            if (next_state == actor_state::ready) {
+                            if (schedule) {
                                 CPPA_LOGMF(CPPA_DEBUG, self, "enqueued actor with id " << id()
                                                << " to job queue");
                                 m_scheduler->enqueue(this);
@@ -133,19 +143,13 @@ actor_state scheduled_actor::compare_exchange_state(actor_state expected,
 }
 
 void scheduled_actor::enqueue(const message_header& hdr, any_tuple msg) {
-    enqueue_impl(actor_state::ready, hdr, std::move(msg));
+    enqueue_impl(true, hdr, std::move(msg));
 }
 
-bool scheduled_actor::chained_enqueue(const message_header& hdr, any_tuple msg) {
-    return enqueue_impl(actor_state::pending, hdr, std::move(msg));
-}
-
-void scheduled_actor::unchain() {
-    auto state = actor_state::pending;
-    if (m_state.compare_exchange_weak(state, actor_state::ready)) {
-        CPPA_REQUIRE(m_scheduler != nullptr);
-        m_scheduler->enqueue(this);
-    }
+scheduled_actor* scheduled_actor::enqueue_batched(const message_header& hdr,
+                                                  any_tuple msg) {
+    return enqueue_impl(false, hdr, std::move(msg))
+           ? this : nullptr;
 }
 
 } // namespace cppa
@@ -33,7 +33,7 @@
 namespace cppa { namespace detail {
 
 scheduled_actor_dummy::scheduled_actor_dummy()
-: scheduled_actor(actor_state::blocked, false) { }
+: scheduled_actor(actor_state::blocked) { }
 
 void scheduled_actor_dummy::enqueue(const message_header&, any_tuple) { }
 void scheduled_actor_dummy::quit(std::uint32_t) { }
@@ -43,7 +43,7 @@ void scheduled_actor_dummy::do_become(behavior&&, bool) { }
 void scheduled_actor_dummy::become_waiting_for(behavior, message_id) { }
 bool scheduled_actor_dummy::has_behavior() { return false; }
 
-resume_result scheduled_actor_dummy::resume(util::fiber*, actor_ptr&) {
+resume_result scheduled_actor_dummy::resume(util::fiber*) {
     return resume_result::actor_blocked;
 }
 
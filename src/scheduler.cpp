@@ -47,6 +47,7 @@
 #include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/singleton_manager.hpp"
 #include "cppa/detail/thread_pool_scheduler.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
 
 using std::move;
 
@@ -277,6 +278,14 @@ attachable* scheduler::register_hidden_context() {
     return new exit_observer;
 }
 
+void scheduler::enqueue_batch(const std::vector<scheduled_actor*>& what) {
+    for (auto job : what) enqueue(job);
+}
+
+scheduler_statistics scheduler::statistics() const {
+    return {0, 0, 0, 0, {}};
+}
+
 void set_scheduler(scheduler* sched) {
     if (detail::singleton_manager::set_scheduler(sched) == false) {
         throw std::runtime_error("scheduler already set");
@@ -287,6 +296,10 @@ void set_default_scheduler(size_t num_threads) {
     set_scheduler(new detail::thread_pool_scheduler(num_threads));
 }
 
+void set_work_stealing_scheduler(size_t num_threads) {
+    set_scheduler(new detail::work_stealing_scheduler(num_threads));
+}
+
 scheduler* scheduler::create_singleton() {
     return new detail::thread_pool_scheduler;
 }
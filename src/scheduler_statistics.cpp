@@ -0,0 +1,73 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <sstream>
+
+#include "cppa/scheduler_statistics.hpp"
+
+namespace cppa {
+
+worker_statistics scheduler_statistics::total() const {
+    worker_statistics result{0, 0, 0, std::chrono::nanoseconds(0),
+                             std::chrono::nanoseconds(0)};
+    for (auto& w : workers) {
+        result.jobs += w.jobs;
+        result.messages += w.messages;
+        result.steals += w.steals;
+        result.busy += w.busy;
+        result.idle += w.idle;
+    }
+    return result;
+}
+
+std::string to_string(const scheduler_statistics& stats) {
+    std::ostringstream oss;
+    auto print = [&](const worker_statistics& w) {
+        oss << "jobs = " << w.jobs
+            << ", messages = " << w.messages
+            << ", steals = " << w.steals
+            << ", utilization = "
+            << static_cast<int>(w.utilization() * 100) << "%"
+            << ", avg resume = " << w.avg_resume_duration().count() << "ns";
+    };
+    oss << "active workers = " << stats.active_workers
+        << ", detached threads = " << stats.detached_threads
+        << " (" << stats.idle_detached_threads << " idle, peak = "
+        << stats.peak_detached_threads << "), ";
+    print(stats.total());
+    for (size_t i = 0; i < stats.workers.size(); ++i) {
+        oss << "\n  worker " << i << ": ";
+        print(stats.workers[i]);
+    }
+    return oss.str();
+}
+
+} // namespace cppa
@@ -31,6 +31,9 @@
 #include "cppa/send.hpp"
 #include "cppa/scheduler.hpp"
 #include "cppa/singletons.hpp"
+#include "cppa/mailbox_element.hpp"
+
+#include "cppa/detail/memory.hpp"
 
 namespace cppa {
 
@@ -38,15 +41,22 @@ message_future sync_send_tuple(actor_destination dest, any_tuple what) {
     if (!dest.receiver) throw std::invalid_argument("whom == nullptr");
     auto req = self->new_request_id();
     message_header hdr{self, std::move(dest.receiver), req, dest.priority};
-    if (self->chaining_enabled()) {
-        if (hdr.receiver->chained_enqueue(hdr, std::move(what))) {
-            self->chained_actor(hdr.receiver.downcast<actor>());
-        }
-    }
-    else hdr.deliver(std::move(what));
+    hdr.deliver(std::move(what));
     return req.response_id();
 }
 
+void send_batch_as(const actor_ptr& from, message_batch msgs) {
+    detail::memory::reserve<mailbox_element>(msgs.size());
+    std::vector<scheduled_actor*> ready;
+    for (auto& kvp : msgs) {
+        if (!kvp.first) continue;
+        auto ptr = kvp.first->enqueue_batched({from, kvp.first},
+                                              std::move(kvp.second));
+        if (ptr) ready.push_back(ptr);
+    }
+    if (!ready.empty()) get_scheduler()->enqueue_batch(ready);
+}
+
 void delayed_send_tuple(channel_destination dest,
                         const util::duration& rtime,
                         any_tuple data) {
@@ -32,8 +32,17 @@
 #include <thread>
 #include <cstdint>
 #include <cstddef>
+#include <iterator>
+#include <algorithm>
 #include <iostream>
 
+#include "cppa/config.hpp"
+
+#ifdef CPPA_LINUX
+#   include <pthread.h>
+#   include <sched.h>
+#endif
+
 #include "cppa/on.hpp"
 #include "cppa/logging.hpp"
 #include "cppa/prioritizing.hpp"
@@ -41,6 +50,8 @@
 #include "cppa/thread_mapped_actor.hpp"
 #include "cppa/context_switching_actor.hpp"
 
+#include "cppa/util/get_cpu_topology.hpp"
+
 #include "cppa/detail/actor_registry.hpp"
 #include "cppa/detail/thread_pool_scheduler.hpp"
 
@@ -49,147 +60,577 @@ using std::endl;
 
 namespace cppa { namespace detail {
 
-struct thread_pool_scheduler::worker {
+namespace {
+
+// points to the worker running in the current thread (if any)
+__thread thread_pool_scheduler::worker* t_worker = nullptr;
+
+constexpr size_t default_spin_budget = 100;
+
+constexpr size_t default_lifo_slot_limit = 16;
+
+constexpr size_t default_aging_threshold = 32;
 
-    typedef scheduled_actor* job_ptr;
+inline size_t index_of(scheduling_priority prio) {
+    return static_cast<size_t>(prio);
+}
+
+// interval between two load samples of the supervisor
+constexpr std::chrono::milliseconds load_sample_interval{50};
 
-    job_queue* m_job_queue;
-    job_ptr m_dummy;
-    std::thread m_thread;
+// number of consecutive samples with idle workers before shrinking
+constexpr size_t shrink_after_samples = 20;
 
-    worker(job_queue* jq, job_ptr dummy) : m_job_queue(jq), m_dummy(dummy) { }
+inline std::int64_t now_in_ns() {
+    using namespace std::chrono;
+    auto t = steady_clock::now().time_since_epoch();
+    return duration_cast<nanoseconds>(t).count();
+}
 
-    void start() {
-        m_thread = std::thread(&thread_pool_scheduler::worker_loop, this);
+void pin_current_thread(int cpu) {
+#   ifdef CPPA_LINUX
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        CPPA_LOGF_WARNING("unable to pin worker thread to CPU " << cpu);
     }
+#   else
+    CPPA_LOGF_WARNING("pinning threads to CPUs is not supported on "
+                      "this platform; ignore CPU " << cpu);
+#   endif
+}
 
-    worker(const worker&) = delete;
+} // namespace <anonymous>
 
-    worker& operator=(const worker&) = delete;
+void thread_pool_scheduler::worker::start() {
+    m_stopped = false;
+    m_thread = std::thread(&thread_pool_scheduler::worker_loop, this);
+}
 
-    bool aggressive(job_ptr& result) {
-        for (int i = 0; i < 100; ++i) {
-            result = m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::yield();
-        }
-        return false;
+bool thread_pool_scheduler::worker::dequeue(job_ptr& result) {
+    while (!retiring() || !confirm_retirement()) {
+        result = m_parent->try_dequeue(this);
+        if (result) return true;
+        ++m_parent->m_idle;
+        bool success = m_parent->m_park_idle_workers
+                     ? aggressive(result) || park(result)
+                     : aggressive(result) || moderate(result) || relaxed(result);
+        --m_parent->m_idle;
+        if (success) return true;
     }
+    return false;
+}
 
-    bool moderate(job_ptr& result) {
-        for (int i = 0; i < 550; ++i) {
-            result =  m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::sleep_for(std::chrono::microseconds(50));
-        }
+bool thread_pool_scheduler::worker::confirm_retirement() {
+    // the supervisor only restarts stopped workers, hence this worker
+    // must not stop after the supervisor skipped it because of a resize()
+    // that activated this worker while it was on its way out
+    std::lock_guard<std::mutex> guard(m_parent->m_supervisor_mtx);
+    if (!retiring()) return false;
+    m_stopped = true;
+    return true;
+}
+
+bool thread_pool_scheduler::worker::aggressive(job_ptr& result) {
+    for (size_t i = 0; i < m_parent->m_spin_budget; ++i) {
+        if (retiring()) return false;
+        result = m_parent->try_dequeue(this);
+        if (result) return true;
+        std::this_thread::yield();
+    }
+    return false;
+}
+
+bool thread_pool_scheduler::worker::moderate(job_ptr& result) {
+    for (int i = 0; i < 550; ++i) {
+        if (retiring()) return false;
+        result = m_parent->try_dequeue(this);
+        if (result) return true;
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    return false;
+}
+
+bool thread_pool_scheduler::worker::relaxed(job_ptr& result) {
+    for (;;) {
+        if (retiring()) return false;
+        result = m_parent->try_dequeue(this);
+        if (result) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+bool thread_pool_scheduler::worker::take_next(job_ptr& result) {
+    if (m_next.load(std::memory_order_relaxed) == nullptr) return false;
+    // another worker might have stolen the job in the meantime
+    result = m_next.exchange(nullptr);
+    if (result == nullptr) return false;
+    if (++m_next_hits > m_parent->lifo_slot_limit()) {
+        CPPA_LOGMF(CPPA_DEBUG, self, "reached limit of consecutive LIFO "
+                   "slot hits; move actor with ID " << result->id()
+                   << " to job queue");
+        // give jobs in the queue a chance to run
+        m_next_hits = 0;
+        m_parent->enqueue_tail(this, result);
+        result = nullptr;
         return false;
     }
+    return true;
+}
 
-    bool relaxed(job_ptr& result) {
-        for (;;) {
-            result =  m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+bool thread_pool_scheduler::worker::park(job_ptr& result) {
+    auto parent = m_parent;
+    std::unique_lock<std::mutex> guard(parent->m_park_mtx);
+    for (;;) {
+        if (retiring()) return false;
+        // announce that we're about to park before checking the job
+        // queue a last time, because enqueue() checks m_parked only after
+        // pushing the new job and we must not miss a notification; all
+        // accesses to m_parked and the job counters are sequentially
+        // consistent, so that either this worker sees the new job or
+        // the producer sees this worker parking
+        ++parent->m_parked;
+        result = parent->try_dequeue(this);
+        if (result) {
+            --parent->m_parked;
+            return true;
         }
+        auto parked_since = now_in_ns();
+        parent->m_park_cv.wait(guard);
+        --parent->m_parked;
+        parent->record_wakeup(parked_since);
+        result = parent->try_dequeue(this);
+        if (result) return true;
     }
+}
 
-    void operator()() {
-        CPPA_LOG_TRACE("");
-        util::fiber fself;
-        job_ptr job = nullptr;
-        actor_ptr next;
-        for (;;) {
-            aggressive(job) || moderate(job) || relaxed(job);
-            CPPA_LOGMF(CPPA_DEBUG, self, "dequeued new job");
-            if (job == m_dummy) {
-                CPPA_LOGMF(CPPA_DEBUG, self, "received dummy (quit)");
-                // dummy of doom received ...
-                m_job_queue->push_back(job); // kill the next guy
-                return;                      // and say goodbye
-            }
-            do {
-                CPPA_LOGMF(CPPA_DEBUG, self, "resume actor with ID " << job->id());
-                CPPA_REQUIRE(next == nullptr);
-                if (job->resume(&fself, next) == resume_result::actor_done) {
+void thread_pool_scheduler::worker::operator()() {
+    CPPA_LOG_TRACE("");
+    t_worker = this;
+    if (m_cpu >= 0) pin_current_thread(m_cpu);
+    util::fiber fself;
+    job_ptr job = nullptr;
+    // timestamps are only taken if m_parent->m_measure_utilization is set,
+    // idle_since is 0 if the previous batch was not measured
+    std::int64_t idle_since = now_in_ns();
+    while (dequeue(job)) {
+        CPPA_LOGMF(CPPA_DEBUG, self, "dequeued new job");
+        if (job == m_dummy) {
+            CPPA_LOGMF(CPPA_DEBUG, self, "received dummy (quit)");
+            // dummy of doom received ...
+            m_parent->enqueue_tail(nullptr, job); // kill the next guy
+            m_parent->wake_up_worker();
+            t_worker = nullptr;
+            m_stopped = true;
+            return;                           // and say goodbye
+        }
+        m_next_hits = 0;
+        bool measure = m_parent->m_measure_utilization.load();
+        std::int64_t busy_since = 0;
+        if (measure) {
+            busy_since = now_in_ns();
+            if (idle_since > 0) count(m_idle_ns, busy_since - idle_since);
+        }
+        do {
+            CPPA_LOGMF(CPPA_DEBUG, self, "resume actor with ID " << job->id());
+            count<std::uint64_t>(m_jobs, 1);
+            switch (job->resume(&fself)) {
+                case resume_result::actor_done: {
                     CPPA_LOGMF(CPPA_DEBUG, self, "actor is done");
                     bool hidden = job->is_hidden();
                     job->deref();
                     if (!hidden) get_actor_registry()->dec_running();
+                    break;
+                }
+                case resume_result::actor_preempted: {
+                    CPPA_LOGMF(CPPA_DEBUG, self, "actor exceeded its "
+                               "throughput budget");
+                    // enqueue at the tail to let other jobs run first
+                    m_parent->enqueue_tail(this, job);
+                    break;
                 }
-                if (next) {
-                    CPPA_LOGMF(CPPA_DEBUG, self, "got new job trough chaining");
-                    job = static_cast<job_ptr>(next.get());
-                    next.reset();
+                case resume_result::actor_suspended: {
+                    CPPA_LOGMF(CPPA_DEBUG, self, "actor waits for a "
+                               "receiver with a full mailbox");
+                    // the receiver enqueues the actor again
+                    break;
                 }
-                else job = nullptr;
+                default: break;
             }
-            while (job); // loops until next == nullptr
+            if (!take_next(job)) job = nullptr;
+        }
+        while (job); // loops until the LIFO slot is empty
+        count(m_messages, scheduled_actor::fetch_processed_messages());
+        if (measure) {
+            idle_since = now_in_ns();
+            count(m_busy_ns, idle_since - busy_since);
         }
+        else idle_since = 0;
     }
-
-};
+    CPPA_LOGMF(CPPA_DEBUG, self, "worker " << m_id << " retires");
+    m_parent->worker_retired(this);
+    t_worker = nullptr;
+    m_stopped = true;
+}
 
 void thread_pool_scheduler::worker_loop(thread_pool_scheduler::worker* w) {
     (*w)();
 }
 
-thread_pool_scheduler::thread_pool_scheduler() {
+thread_pool_scheduler::thread_pool_scheduler()
+: m_pin_workers(false), m_park_idle_workers(false)
+, m_spin_budget(default_spin_budget)
+, m_lifo_slot_limit(default_lifo_slot_limit)
+, m_aging_threshold(default_aging_threshold)
+, m_measure_utilization(false), m_log_interval(0)
+, m_adaptive_resizing(true)
+, m_idle(0), m_shared_jobs(), m_shutdown(false)
+, m_parked(0), m_last_notify(0), m_wakeups(0)
+, m_total_wakeup_latency(0), m_max_wakeup_latency(0) {
     m_num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+    m_min_workers = m_num_threads;
+    m_active = m_num_threads;
 }
 
-thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads) {
+thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads)
+: m_pin_workers(false), m_park_idle_workers(false)
+, m_spin_budget(default_spin_budget)
+, m_lifo_slot_limit(default_lifo_slot_limit)
+, m_aging_threshold(default_aging_threshold)
+, m_measure_utilization(false), m_log_interval(0)
+, m_adaptive_resizing(true)
+, m_idle(0), m_shared_jobs(), m_shutdown(false)
+, m_parked(0), m_last_notify(0), m_wakeups(0)
+, m_total_wakeup_latency(0), m_max_wakeup_latency(0) {
     m_num_threads = num_worker_threads;
+    m_min_workers = num_worker_threads;
+    m_active = num_worker_threads;
 }
 
-void thread_pool_scheduler::supervisor_loop(job_queue* jqueue,
-                                            scheduled_actor* dummy,
-                                            size_t num_threads) {
-    std::vector<std::unique_ptr<thread_pool_scheduler::worker> > workers;
-    for (size_t i = 0; i < num_threads; ++i) {
-        workers.emplace_back(new worker(jqueue, dummy));
-        workers.back()->start();
+void thread_pool_scheduler::supervisor_loop(thread_pool_scheduler* sched) {
+    using std::chrono::steady_clock;
+    std::unique_lock<std::mutex> guard(sched->m_supervisor_mtx);
+    size_t idle_samples = 0;
+    bool adapt = sched->m_min_workers < sched->m_num_threads;
+    auto log_interval = sched->m_log_interval;
+    auto next_log = steady_clock::now() + log_interval;
+    while (!sched->m_shutdown) {
+        sched->apply_worker_count();
+        if (adapt) {
+            sched->m_supervisor_cv.wait_for(guard, load_sample_interval);
+        }
+        else if (log_interval.count() > 0) {
+            sched->m_supervisor_cv.wait_until(guard, next_log);
+        }
+        else sched->m_supervisor_cv.wait(guard);
+        if (sched->m_shutdown) break;
+        if (adapt && sched->m_adaptive_resizing) {
+            sched->adapt_worker_count(idle_samples);
+        }
+        if (log_interval.count() > 0 && steady_clock::now() >= next_log) {
+            CPPA_LOG_INFO("scheduler statistics: "
+                          << to_string(sched->statistics()));
+            next_log += log_interval;
+        }
     }
+    guard.unlock();
     // wait for workers
-    for (auto& w : workers) {
-        w->m_thread.join();
+    for (auto& w : sched->m_workers) {
+        if (w->m_thread.joinable()) w->m_thread.join();
+    }
+}
+
+void thread_pool_scheduler::apply_worker_count() {
+    auto active = m_active.load();
+    for (auto& w : m_workers) {
+        if (w->m_stopped && w->m_thread.joinable()) w->m_thread.join();
+        // a retiring worker that did not stop yet notices the new
+        // value of m_active in confirm_retirement() and keeps running
+        if (w->m_id < active && !w->m_thread.joinable()) {
+            CPPA_LOG_DEBUG("start worker " << w->m_id);
+            w->start();
+        }
+    }
+}
+
+void thread_pool_scheduler::adapt_worker_count(size_t& idle_samples) {
+    auto active = m_active.load();
+    auto idle = m_idle.load();
+    if (idle == 0 && active < m_num_threads && queued_jobs() > active) {
+        CPPA_LOG_DEBUG("all workers busy, grow to " << (active + 1));
+        idle_samples = 0;
+        set_active_workers(active + 1);
+    }
+    else if (idle > 1 && active > m_min_workers) {
+        if (++idle_samples >= shrink_after_samples) {
+            CPPA_LOG_DEBUG(idle << " idle workers, shrink to " << (active - 1));
+            idle_samples = 0;
+            set_active_workers(active - 1);
+        }
+    }
+    else idle_samples = 0;
+}
+
+scheduler_statistics thread_pool_scheduler::statistics() const {
+    scheduler_statistics result;
+    result.active_workers = m_active.load();
+    result.detached_threads = m_detached.num_threads();
+    result.idle_detached_threads = m_detached.num_idle_threads();
+    result.peak_detached_threads = m_detached.peak_threads();
+    auto ns = [](const std::atomic<std::int64_t>& value) {
+        return std::chrono::nanoseconds(value.load(std::memory_order_relaxed));
+    };
+    for (auto& w : m_workers) {
+        result.workers.push_back({w->m_jobs.load(std::memory_order_relaxed),
+                                  w->m_messages.load(std::memory_order_relaxed),
+                                  w->m_steals.load(std::memory_order_relaxed),
+                                  ns(w->m_busy_ns), ns(w->m_idle_ns)});
+    }
+    return result;
+}
+
+void thread_pool_scheduler::worker_bounds(size_t min_workers,
+                                          size_t max_workers) {
+    CPPA_REQUIRE(min_workers > 0 && min_workers <= max_workers);
+    m_min_workers = min_workers;
+    m_num_threads = max_workers;
+    m_active = std::min(std::max(m_active.load(), min_workers), max_workers);
+}
+
+void thread_pool_scheduler::adaptive_resizing(bool value) {
+    // the supervisor adapts the worker count while holding the lock,
+    // i.e., no adaptation is in progress once we acquired it
+    std::lock_guard<std::mutex> guard(m_supervisor_mtx);
+    m_adaptive_resizing = value;
+}
+
+void thread_pool_scheduler::resize(size_t num_workers) {
+    if (set_active_workers(num_workers)) {
+        // the supervisor starts new workers and joins retired ones
+        std::lock_guard<std::mutex> guard(m_supervisor_mtx);
+        m_supervisor_cv.notify_all();
     }
 }
 
+bool thread_pool_scheduler::set_active_workers(size_t num_workers) {
+    num_workers = std::min(std::max(num_workers, m_min_workers),
+                           m_num_threads);
+    auto old_value = m_active.exchange(num_workers);
+    if (old_value == num_workers) return false;
+    CPPA_LOG_INFO("resize from " << old_value << " to "
+                  << num_workers << " workers");
+    // parked workers check whether they retire when woken up
+    if (num_workers < old_value) notify_parked(true);
+    return true;
+}
+
 void thread_pool_scheduler::initialize() {
-    m_supervisor = std::thread(&thread_pool_scheduler::supervisor_loop,
-                               &m_queue, &m_dummy, m_num_threads);
+    // workers are created upfront, because job queue
+    // implementations might access them by ID; workers with
+    // ID >= num_active_workers() are started on demand
+    for (size_t i = 0; i < m_num_threads; ++i) {
+        m_workers.emplace_back(new worker(this, i, &m_dummy));
+    }
+    if (m_pin_workers) {
+        // distribute workers round-robin over NUMA nodes
+        auto nodes = util::get_cpu_topology();
+        for (auto& w : m_workers) {
+            w->m_node = w->m_id % nodes.size();
+            auto& cpus = nodes[w->m_node];
+            w->m_cpu = cpus[(w->m_id / nodes.size()) % cpus.size()];
+            CPPA_LOG_DEBUG("pin worker " << w->m_id << " to CPU "
+                           << w->m_cpu << " on node " << w->m_node);
+        }
+    }
+    m_supervisor = std::thread(&thread_pool_scheduler::supervisor_loop, this);
     super::initialize();
 }
 
 void thread_pool_scheduler::destroy() {
     CPPA_LOG_TRACE("");
-    m_queue.push_back(&m_dummy);
+    enqueue_tail(nullptr, &m_dummy);
+    notify_parked(true);
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard(m_supervisor_mtx);
+        m_shutdown = true;
+        m_supervisor_cv.notify_all();
+    }
     CPPA_LOGMF(CPPA_DEBUG, self, "join supervisor");
     m_supervisor.join();
-    // make sure job queue is empty, because destructor of m_queue would
-    // otherwise delete elements it shouldn't
+    // make sure all job queues are empty, because destructor of m_queues
+    // would otherwise delete elements it shouldn't
     CPPA_LOGMF(CPPA_DEBUG, self, "flush queue");
-    auto ptr = m_queue.try_pop();
-    while (ptr != nullptr) {
-        if (ptr != &m_dummy) {
-            bool hidden = ptr->is_hidden();
-            ptr->deref();
-            std::atomic_thread_fence(std::memory_order_seq_cst);
-            if (!hidden) get_actor_registry()->dec_running();
+    for (auto& w : m_workers) {
+        auto ptr = try_dequeue(w.get());
+        while (ptr != nullptr) {
+            if (ptr != &m_dummy) {
+                bool hidden = ptr->is_hidden();
+                ptr->deref();
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!hidden) get_actor_registry()->dec_running();
+            }
+            ptr = try_dequeue(w.get());
         }
-        ptr = m_queue.try_pop();
     }
     super::destroy();
 }
 
 void thread_pool_scheduler::enqueue(scheduled_actor* what) {
-    m_queue.push_back(what);
+    auto w = current_worker();
+    // jobs of the lowest class must not overtake waiting jobs
+    if (w && lifo_slot_limit() > 0
+          && what->priority() != scheduling_priority::low) {
+        what = w->m_next.exchange(what);
+        // w is still busy with its current job, i.e., an idle worker
+        // should take the job from the slot rather than waiting for w
+        wake_up_worker();
+        if (what == nullptr) return;
+    }
+    enqueue_tail(w, what);
+}
+
+void thread_pool_scheduler::enqueue_tail(worker*, scheduled_actor* what) {
+    auto i = index_of(what->priority());
+    ++m_shared_jobs[i];
+    m_queues[i].push_back(what);
+    wake_up_worker();
+}
+
+void thread_pool_scheduler::enqueue_batch(const std::vector<scheduled_actor*>& what) {
+    if (!what.empty()) enqueue_tail(current_worker(), what);
+}
+
+void thread_pool_scheduler::enqueue_tail(worker*,
+                                         const std::vector<scheduled_actor*>& what) {
+    // append each run of jobs with the same class in one operation
+    auto first = what.begin();
+    while (first != what.end()) {
+        auto prio = (*first)->priority();
+        auto last = std::find_if(first, what.end(), [=](scheduled_actor* job) {
+            return job->priority() != prio;
+        });
+        auto i = index_of(prio);
+        m_shared_jobs[i] += static_cast<size_t>(std::distance(first, last));
+        m_queues[i].push_back(first, last);
+        first = last;
+    }
+    wake_up_workers(what.size());
+}
+
+size_t thread_pool_scheduler::queued_jobs() const {
+    size_t result = 0;
+    for (auto& n : m_shared_jobs) result += n.load(std::memory_order_relaxed);
+    return result;
+}
+
+void thread_pool_scheduler::worker_retired(worker*) {
+    // jobs of the shared queue are available to all workers
+}
+
+void thread_pool_scheduler::notify_parked(bool all) {
+    std::lock_guard<std::mutex> guard(m_park_mtx);
+    m_last_notify = now_in_ns();
+    if (all) m_park_cv.notify_all();
+    else m_park_cv.notify_one();
+}
+
+void thread_pool_scheduler::record_wakeup(std::int64_t parked_since) {
+    auto notified = m_last_notify.load();
+    // ignore spurious wakeups
+    if (notified < parked_since) return;
+    auto latency = now_in_ns() - notified;
+    ++m_wakeups;
+    m_total_wakeup_latency += latency;
+    auto max = m_max_wakeup_latency.load();
+    while (latency > max) {
+        if (m_max_wakeup_latency.compare_exchange_weak(max, latency)) break;
+    }
+    CPPA_LOG_DEBUG("wake-up latency: " << latency << "ns");
+}
+
+std::chrono::nanoseconds thread_pool_scheduler::avg_wakeup_latency() const {
+    auto n = m_wakeups.load();
+    if (n == 0) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(m_total_wakeup_latency.load()
+                                    / static_cast<std::int64_t>(n));
+}
+
+scheduled_actor* thread_pool_scheduler::try_dequeue(worker* w) {
+    using sp = scheduling_priority;
+    auto result = steal_next(w, false);
+    if (!result && passed_over(w, sp::low, shared_jobs(sp::low) > 0)) {
+        result = try_dequeue_shared(sp::low);
+    }
+    if (!result && passed_over(w, sp::normal, shared_jobs(sp::normal) > 0)) {
+        result = try_dequeue_shared(sp::normal);
+    }
+    if (!result) result = try_dequeue_shared(sp::high);
+    if (!result) result = try_dequeue_shared(sp::normal);
+    if (!result) result = try_dequeue_shared(sp::low);
+    if (!result) result = steal_next(w, true);
+    return result;
+}
+
+scheduled_actor* thread_pool_scheduler::steal_next(worker* thief, bool idle) {
+    if (!idle) {
+        auto threshold = aging_threshold();
+        if (thief == nullptr || threshold == 0) return nullptr;
+        if (++thief->m_passed_over_slots <= threshold) return nullptr;
+    }
+    if (thief) thief->m_passed_over_slots = 0;
+    for (auto& w : m_workers) {
+        if (w->m_next.load(std::memory_order_relaxed) == nullptr) continue;
+        auto result = w->m_next.exchange(nullptr);
+        if (result) {
+            if (thief && thief != w.get()) {
+                worker::count<std::uint64_t>(thief->m_steals, 1);
+                CPPA_LOGMF(CPPA_DEBUG, self, "worker " << thief->m_id
+                           << " stole actor with ID " << result->id()
+                           << " from the LIFO slot of worker " << w->m_id);
+            }
+            return result;
+        }
+    }
+    return nullptr;
+}
+
+scheduled_actor* thread_pool_scheduler::try_dequeue_shared(scheduling_priority prio) {
+    auto i = index_of(prio);
+    // avoid locking empty queues, since most jobs use a single class;
+    // park() relies on this load being sequentially consistent, because
+    // a relaxed load could be reordered before its increment of m_parked
+    // and thus miss a job whose producer didn't see the parked worker
+    if (m_shared_jobs[i].load() == 0) return nullptr;
+    auto result = m_queues[i].try_pop();
+    if (result) --m_shared_jobs[i];
+    return result;
+}
+
+bool thread_pool_scheduler::passed_over(worker* w, scheduling_priority prio,
+                                        bool waiting) {
+    auto threshold = aging_threshold();
+    if (w == nullptr || threshold == 0) return false;
+    auto& counter = w->m_passed_over[index_of(prio)];
+    if (!waiting) counter = 0;
+    else if (++counter > threshold) {
+        CPPA_LOGMF(CPPA_DEBUG, self, "worker " << w->m_id << " passed over "
+                   "jobs of class " << index_of(prio) << " too often");
+        counter = 0;
+        return true;
+    }
+    return false;
+}
+
+thread_pool_scheduler::worker* thread_pool_scheduler::current_worker() const {
+    return (t_worker && t_worker->m_parent == this) ? t_worker : nullptr;
 }
 
 template<typename F>
-void exec_as_thread(bool is_hidden, local_actor_ptr p, F f) {
+void exec_as_thread(detached_thread_pool& pool, bool is_hidden,
+                    local_actor_ptr p, F f) {
     if (!is_hidden) get_actor_registry()->inc_running();
-    std::thread([=] {
+    pool.run([=] {
         scoped_self_setter sss(p.get());
         try { f(); }
         catch (...) { }
@@ -197,23 +638,27 @@ void exec_as_thread(bool is_hidden, local_actor_ptr p, F f) {
             std::atomic_thread_fence(std::memory_order_seq_cst);
             get_actor_registry()->dec_running();
         }
-    }).detach();
+    });
 }
 
 local_actor_ptr thread_pool_scheduler::exec(spawn_options os, scheduled_actor_ptr p) {
     CPPA_REQUIRE(p != nullptr);
+    p->configure_mailbox(os);
     bool is_hidden = has_hide_flag(os);
     if (has_detach_flag(os)) {
-        exec_as_thread(is_hidden, p, [p] {
+        exec_as_thread(m_detached, is_hidden, p, [p] {
             p->run_detached();
         });
         return p;
     }
+    p->max_throughput(static_cast<size_t>(get_max_throughput(os)));
+    if (has_high_priority_flag(os)) p->priority(scheduling_priority::high);
+    else if (has_low_priority_flag(os)) p->priority(scheduling_priority::low);
     p->attach_to_scheduler(this, is_hidden);
     if (p->has_behavior() || p->impl_type() == default_event_based_impl) {
         if (!is_hidden) get_actor_registry()->inc_running();
         p->ref(); // implicit reference that's released if actor dies
-        if (p->impl_type() != event_based_impl) m_queue.push_back(p.get());
+        if (p->impl_type() != event_based_impl) enqueue(p.get());
     }
     else p->on_exit();
     return p;
@@ -230,8 +675,10 @@ local_actor_ptr thread_pool_scheduler::exec(spawn_options os,
     };
     if (has_priority_aware_flag(os)) {
         using impl = extend<thread_mapped_actor>::with<prioritizing>;
-        set_result(make_counted<impl>());
-        exec_as_thread(has_hide_flag(os), result, [result, f] {
+        auto p = make_counted<impl>();
+        p->configure_mailbox(os);
+        set_result(std::move(p));
+        exec_as_thread(m_detached, has_hide_flag(os), result, [result, f] {
             try {
                 f();
                 result->exec_behavior_stack();
@@ -261,8 +708,9 @@ local_actor_ptr thread_pool_scheduler::exec(spawn_options os,
 #       endif
         /* else tree */ {
             auto p = make_counted<thread_mapped_actor>(std::move(f));
+            p->configure_mailbox(os);
             set_result(p);
-            exec_as_thread(has_hide_flag(os), p, [p] {
+            exec_as_thread(m_detached, has_hide_flag(os), p, [p] {
                 p->run();
                 p->on_exit();
             });
@@ -0,0 +1,179 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <mutex>
+#include <algorithm>
+
+#include "cppa/logging.hpp"
+
+#include "cppa/detail/work_stealing_scheduler.hpp"
+
+namespace cppa { namespace detail {
+
+typedef std::lock_guard<util::shared_spinlock> exclusive_guard;
+
+work_stealing_scheduler::local_queue::local_queue() : m_size(0) { }
+
+size_t work_stealing_scheduler::local_queue::push_back(scheduled_actor* what) {
+    exclusive_guard guard(m_lock);
+    m_data.push_back(what);
+    m_size = m_data.size();
+    return m_data.size();
+}
+
+size_t work_stealing_scheduler::local_queue::push_back(const std::vector<scheduled_actor*>& what) {
+    exclusive_guard guard(m_lock);
+    m_data.insert(m_data.end(), what.begin(), what.end());
+    m_size = m_data.size();
+    return m_data.size();
+}
+
+scheduled_actor* work_stealing_scheduler::local_queue::pop_front() {
+    if (empty()) return nullptr;
+    exclusive_guard guard(m_lock);
+    if (m_data.empty()) return nullptr;
+    auto result = m_data.front();
+    m_data.pop_front();
+    m_size = m_data.size();
+    return result;
+}
+
+scheduled_actor* work_stealing_scheduler::local_queue::pop_back() {
+    if (empty()) return nullptr;
+    exclusive_guard guard(m_lock);
+    if (m_data.empty()) return nullptr;
+    auto result = m_data.back();
+    m_data.pop_back();
+    m_size = m_data.size();
+    return result;
+}
+
+work_stealing_scheduler::work_stealing_scheduler() { }
+
+work_stealing_scheduler::work_stealing_scheduler(size_t num_worker_threads)
+: super(num_worker_threads) { }
+
+void work_stealing_scheduler::initialize() {
+    // local queues must exist before the first worker starts
+    for (size_t i = 0; i < num_workers(); ++i) {
+        m_local_queues.emplace_back(new local_queue);
+    }
+    super::initialize();
+}
+
+void work_stealing_scheduler::enqueue_tail(worker* w,
+                                           scheduled_actor* what) {
+    // jobs of other classes are ordered by class in the shared queues
+    if (w && what->priority() == scheduling_priority::normal) {
+        m_local_queues[w->m_id]->push_back(what);
+        // the owner might have another job in its LIFO slot and runs
+        // the current one until its budget is exhausted, hence an idle
+        // worker should steal this job even if it's the only one
+        wake_up_worker();
+    }
+    else super::enqueue_tail(w, what);
+}
+
+void work_stealing_scheduler::enqueue_tail(worker* w,
+                                           const std::vector<scheduled_actor*>& what) {
+    auto normal = [](scheduled_actor* job) {
+        return job->priority() == scheduling_priority::normal;
+    };
+    if (w && std::all_of(what.begin(), what.end(), normal)) {
+        // the owner picks up one job by itself
+        auto size = m_local_queues[w->m_id]->push_back(what);
+        wake_up_workers(std::min(what.size(), size - 1));
+    }
+    else super::enqueue_tail(w, what);
+}
+
+size_t work_stealing_scheduler::queued_jobs() const {
+    auto result = super::queued_jobs();
+    for (auto& q : m_local_queues) result += q->size();
+    return result;
+}
+
+void work_stealing_scheduler::worker_retired(worker* w) {
+    // move all jobs to the shared queue, since no other
+    // worker steals from w if all of them are parked
+    auto& q = m_local_queues[w->m_id];
+    for (auto job = q->pop_front(); job != nullptr; job = q->pop_front()) {
+        super::enqueue_tail(nullptr, job);
+    }
+}
+
+scheduled_actor* work_stealing_scheduler::try_dequeue(worker* w) {
+    using sp = scheduling_priority;
+    auto& local = *m_local_queues[w->m_id];
+    auto result = steal_next(w, false);
+    if (!result && passed_over(w, sp::low, shared_jobs(sp::low) > 0)) {
+        result = try_dequeue_shared(sp::low);
+    }
+    if (!result && passed_over(w, sp::normal, !local.empty()
+                                              || shared_jobs(sp::normal) > 0)) {
+        result = local.pop_front();
+        if (!result) result = try_dequeue_shared(sp::normal);
+    }
+    // local queues only hold jobs of the normal class
+    if (!result) result = try_dequeue_shared(sp::high);
+    if (!result) result = local.pop_front();
+    // jobs enqueued by threads that are not part of this scheduler
+    if (!result) result = try_dequeue_shared(sp::normal);
+    if (!result) result = try_dequeue_shared(sp::low);
+    if (!result) result = steal(w);
+    if (!result) result = steal_next(w, true);
+    return result;
+}
+
+scheduled_actor* work_stealing_scheduler::steal(worker* thief) {
+    auto n = m_local_queues.size();
+    // steal from workers on the same NUMA node first to keep actors
+    // close to their memory, then from all remaining workers
+    for (int local = 1; local >= 0; --local) {
+        // start with the right neighbor to spread steal attempts evenly
+        for (size_t i = 1; i < n; ++i) {
+            auto id = (thief->m_id + i) % n;
+            auto same_node = worker_at(id)->m_node == thief->m_node;
+            if (same_node != (local == 1)) continue;
+            auto result = m_local_queues[id]->pop_back();
+            if (result) {
+                worker::count<std::uint64_t>(thief->m_steals, 1);
+                CPPA_LOGMF(CPPA_DEBUG, self, "worker " << thief->m_id
+                           << " stole actor with ID " << result->id()
+                           << " from worker " << id);
+                return result;
+            }
+        }
+    }
+    return nullptr;
+}
+
+} } // namespace cppa::detail
@@ -28,9 +28,11 @@
 \******************************************************************************/
 
 
+#include <memory>
 #include <iterator>
 
 #include "test.hpp"
+#include "cppa/intrusive/singly_linked_list.hpp"
 #include "cppa/intrusive/single_reader_queue.hpp"
 
 using std::begin;
@@ -68,9 +70,11 @@ int main() {
     q.enqueue(new iint(3));
 
     CPPA_CHECK_EQUAL(3, s_iint_instances);
+    CPPA_CHECK_EQUAL(q.size(), 3u);
 
     auto x = q.try_pop();
     CPPA_CHECK_EQUAL(x->value, 1);
+    CPPA_CHECK_EQUAL(q.size(), 2u);
     delete x;
     x = q.try_pop();
     CPPA_CHECK_EQUAL(x->value, 2);
@@ -80,6 +84,49 @@ int main() {
     delete x;
     x = q.try_pop();
     CPPA_CHECK(x == nullptr);
+    CPPA_CHECK_EQUAL(q.size(), 0u);
+
+    {
+        // elements with the same hint keep their order in a sharded queue
+        iint_queue sq;
+        sq.shards(3);
+        CPPA_CHECK_EQUAL(sq.shards(), 4u);
+        for (int i = 0; i < 8; ++i) sq.enqueue(new iint(i), i % 4);
+        CPPA_CHECK_EQUAL(sq.size(), 8u);
+        int last[4] = {-1, -1, -1, -1};
+        size_t popped = 0;
+        for (auto e = sq.try_pop(); e != nullptr; e = sq.try_pop()) {
+            CPPA_CHECK(last[e->value % 4] < e->value);
+            last[e->value % 4] = e->value;
+            ++popped;
+            delete e;
+        }
+        CPPA_CHECK_EQUAL(popped, 8u);
+        CPPA_CHECK(sq.empty());
+        sq.enqueue(new iint(8), 1);
+    }
+    CPPA_CHECK_EQUAL(0, s_iint_instances);
+
+    {
+        cppa::intrusive::singly_linked_list<iint> l;
+        for (int i = 1; i <= 4; ++i) l.push_back(new iint(i));
+        CPPA_CHECK_EQUAL(4, s_iint_instances);
+        // erase head, middle and tail element
+        auto next = l.erase_after(nullptr);
+        CPPA_CHECK_EQUAL(next->value, 2);
+        next = l.erase_after(next);
+        CPPA_CHECK_EQUAL(next->value, 4);
+        l.erase(next);
+        CPPA_CHECK_EQUAL(1, s_iint_instances);
+        CPPA_CHECK(l.front() == l.back());
+        CPPA_CHECK_EQUAL(l.back()->value, 2);
+        l.push_back(new iint(5));
+        CPPA_CHECK_EQUAL(l.front()->next->value, 5);
+        std::unique_ptr<iint> y{l.take_after(nullptr)};
+        CPPA_CHECK_EQUAL(y->value, 2);
+        CPPA_CHECK(l.front() == l.back());
+    }
+    CPPA_CHECK_EQUAL(0, s_iint_instances);
 
     return CPPA_TEST_RESULT();
 }
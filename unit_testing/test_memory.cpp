@@ -0,0 +1,186 @@
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+
+#include "cppa/cppa.hpp"
+#include "cppa/mailbox_element.hpp"
+#include "cppa/detail/memory.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t num_elements = 20000;
+
+constexpr int num_rounds = 10;
+
+} // namespace <anonymous>
+
+void test_cross_thread_recycling() {
+    CPPA_PRINT("test recycling of mailbox elements released by another thread");
+    detail::memory_counters first_round;
+    for (int round = 0; round < num_rounds; ++round) {
+        vector<mailbox_element*> elements;
+        elements.reserve(num_elements);
+        for (size_t i = 0; i < num_elements; ++i) {
+            elements.push_back(mailbox_element::create(message_header{},
+                                                       make_any_tuple(i)));
+        }
+        // the consumer returns all elements when its cache is destroyed
+        thread consumer{[&] {
+            for (auto e : elements) detail::disposer{}(e);
+        }};
+        consumer.join();
+        if (round == 0) first_round = detail::memory::thread_counters();
+    }
+#   ifndef CPPA_DISABLE_MEM_MANAGEMENT
+    // all rounds after the first one use the returned elements, whereas
+    // malloc could hand out the same addresses without a return path
+    auto counters = detail::memory::thread_counters();
+    CPPA_CHECK_EQUAL(counters.chunks, first_round.chunks);
+    CPPA_CHECK(counters.returned >= (num_rounds - 1) * num_elements);
+#   endif
+}
+
+void test_tuple_slabs() {
+    CPPA_PRINT("test size-class slabs of tuple_vals");
+    // small tuples are recycled by the calling thread, i.e., only the
+    // first tuple might need a new chunk
+    auto tup = make_any_tuple(size_t{0}, string("hello slab"));
+    tup.reset();
+    auto before = detail::memory::thread_counters();
+    for (size_t i = 0; i < num_elements; ++i) {
+        tup = make_any_tuple(i, string("hello slab"));
+    }
+    tup.reset();
+#   ifndef CPPA_DISABLE_MEM_MANAGEMENT
+    auto after = detail::memory::thread_counters();
+    CPPA_CHECK_EQUAL(after.blocks - before.blocks, num_elements);
+    CPPA_CHECK_EQUAL(after.chunks, before.chunks);
+#   endif
+    // size classes are used in ascending order, large objects bypass them
+    auto& cfg = detail::memory::settings();
+    CPPA_CHECK(is_sorted(cfg.size_classes.begin(), cfg.size_classes.end()));
+    for (auto size : {size_t{1}, cfg.size_classes.back(),
+                      cfg.size_classes.back() + 1}) {
+        auto ptr = detail::memory::allocate(size);
+        memset(ptr, 0xFF, size);
+        detail::memory::deallocate(ptr, size);
+    }
+    // tuples released by another thread are returned to this thread
+    detail::memory_counters first_round;
+    for (int round = 0; round < num_rounds; ++round) {
+        vector<any_tuple> tuples;
+        tuples.reserve(num_elements);
+        for (size_t i = 0; i < num_elements; ++i) {
+            tuples.push_back(make_any_tuple(i));
+        }
+        thread consumer{[&] { tuples.clear(); }};
+        consumer.join();
+        if (round == 0) first_round = detail::memory::thread_counters();
+    }
+#   ifndef CPPA_DISABLE_MEM_MANAGEMENT
+    auto counters = detail::memory::thread_counters();
+    CPPA_CHECK_EQUAL(counters.chunks, first_round.chunks);
+    CPPA_CHECK(counters.returned - first_round.returned
+               >= (num_rounds - 1) * num_elements);
+#   endif
+}
+
+namespace {
+
+bool is_inlined(mailbox_element* e) {
+    auto first = reinterpret_cast<const char*>(e);
+    auto ptr = reinterpret_cast<const char*>(e->msg.cvals().get());
+    return ptr >= first && ptr < first + sizeof(mailbox_element);
+}
+
+} // namespace <anonymous>
+
+void test_inline_messages() {
+    CPPA_PRINT("test inline storage of small messages");
+    detail::disposer dispose;
+    auto e = mailbox_element::create(message_header{},
+                                     make_any_tuple(atom("ping"), 42));
+#   if CPPA_INLINE_MESSAGE_SIZE > 0
+    CPPA_CHECK(is_inlined(e));
+#   endif
+    CPPA_CHECK(match(e->msg) (on(atom("ping"), 42) >> [] { }));
+    // a copy keeps the inlined tuple alive after the element was released
+    any_tuple copy = e->msg;
+    dispose(e);
+    CPPA_CHECK(match(copy) (on(atom("ping"), 42) >> [] { }));
+    // messages shared with other actors are not moved
+    e = mailbox_element::create(message_header{}, copy);
+    CPPA_CHECK(!is_inlined(e));
+    copy.reset();
+    dispose(e);
+    // sharing or forwarding a message moves it to the heap first
+    e = mailbox_element::create(message_header{},
+                                make_any_tuple(atom("ping"), 42));
+    e->move_msg_to_heap();
+    CPPA_CHECK(!is_inlined(e));
+    copy = e->msg;
+    dispose(e);
+    CPPA_CHECK(match(copy) (on(atom("ping"), 42) >> [] { }));
+    copy.reset();
+#   if CPPA_INLINE_MESSAGE_SIZE > 0 && !defined(CPPA_DISABLE_MEM_MANAGEMENT)
+    // a message built in place needs a single allocation
+    // and an existing tuple needs its own heap object
+    auto allocations = [](const detail::memory_counters& before) {
+        auto after = detail::memory::thread_counters();
+        return (after.instances - before.instances)
+               + (after.blocks - before.blocks);
+    };
+    auto counters = detail::memory::thread_counters();
+    e = mailbox_element::create(message_header{},
+                                mailbox_element::make_embedded(atom("ping"),
+                                                               42));
+    CPPA_CHECK_EQUAL(allocations(counters), 1);
+    CPPA_CHECK(is_inlined(e));
+    dispose(e);
+    counters = detail::memory::thread_counters();
+    e = mailbox_element::create(message_header{},
+                                make_any_tuple(atom("ping"), 42));
+    CPPA_CHECK_EQUAL(allocations(counters), 2);
+    dispose(e);
+    // send() builds messages in place
+    actor_ptr me = self; // converts this thread to an actor beforehand
+    counters = detail::memory::thread_counters();
+    send(me, atom("ping"), 42);
+    CPPA_CHECK_EQUAL(allocations(counters), 1);
+    receive (
+        on(atom("ping"), 42) >> CPPA_CHECKPOINT_CB()
+    );
+    // a message that never reaches a mailbox releases its element
+    counters = detail::memory::thread_counters();
+    auto msg = mailbox_element::make_embedded(atom("ping"), 42);
+    CPPA_CHECK(match(msg) (on(atom("ping"), 42) >> [] { }));
+    msg.reset();
+    e = mailbox_element::create(message_header{},
+                                mailbox_element::make_embedded(atom("ping"),
+                                                               42));
+    CPPA_CHECK_EQUAL(counters.chunks, detail::memory::thread_counters().chunks);
+    dispose(e);
+#   endif
+    // messages exceeding the inline storage stay on the heap
+    string large(1024, 'x');
+    e = mailbox_element::create(message_header{},
+                                make_any_tuple(large, large, large));
+    CPPA_CHECK(!is_inlined(e));
+    dispose(e);
+}
+
+int main() {
+    CPPA_TEST(test_memory);
+    test_cross_thread_recycling();
+    test_tuple_slabs();
+    test_inline_messages();
+    shutdown();
+    return CPPA_TEST_RESULT();
+}
@@ -326,6 +326,9 @@ int main(int argc, char** argv) {
         }
         else {
             run_client_part(get_kv_pairs(argc, argv), [](uint16_t port) {
+                // the client coalesces outgoing messages, the server doesn't
+                flush_delay(chrono::microseconds(200));
+                CPPA_CHECK(flush_delay() == chrono::microseconds(200));
                 auto serv = remote_actor("localhost", port);
                 // remote_actor is supposed to return the same server
                 // when connecting to the same host again
@@ -0,0 +1,334 @@
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
+
+#include "test.hpp"
+#include "ping_pong.hpp"
+
+#include "cppa/cppa.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr int num_receivers = 1000;
+
+atomic<size_t> s_finished;
+
+void chain_link(actor_ptr next) {
+    become (
+        on(atom("token"), arg_match) >> [=](int hops) {
+            if (next) send(next, atom("token"), hops - 1);
+            ++s_finished;
+            self->quit();
+        }
+    );
+}
+
+void fan_out_receiver(actor_ptr collector) {
+    become (
+        on(atom("job"), arg_match) >> [=](int value) {
+            send(collector, atom("result"), value);
+            self->quit();
+        }
+    );
+}
+
+} // namespace <anonymous>
+
+void test_fan_out() {
+    CPPA_PRINT("test fan-out from within an actor");
+    auto collector = spawn<blocking_api>([] {
+        int sum = 0;
+        int i = 0;
+        receive_for(i, num_receivers) (
+            on(atom("result"), arg_match) >> [&](int value) { sum += value; }
+        );
+        CPPA_CHECK_EQUAL(sum, (num_receivers * (num_receivers - 1)) / 2);
+    });
+    // spawned and woken actors are enqueued to the local job queue
+    // of the sender's worker and can be stolen by other workers
+    spawn([=] {
+        for (int i = 0; i < num_receivers; ++i) {
+            auto r = spawn(fan_out_receiver, collector);
+            send(r, atom("job"), i);
+        }
+    });
+    await_all_others_done();
+    CPPA_CHECKPOINT();
+}
+
+void test_batch_send() {
+    CPPA_PRINT("test fan-out via send_batch");
+    auto collector = spawn<blocking_api>([] {
+        int sum = 0;
+        int i = 0;
+        receive_for(i, num_receivers) (
+            on(atom("result"), arg_match) >> [&](int value) { sum += value; }
+        );
+        CPPA_CHECK_EQUAL(sum, (num_receivers * (num_receivers - 1)) / 2);
+    });
+    spawn([=] {
+        message_batch batch;
+        for (int i = 0; i < num_receivers; ++i) {
+            batch.emplace_back(spawn(fan_out_receiver, collector),
+                               make_any_tuple(atom("job"), i));
+        }
+        send_batch(std::move(batch));
+    });
+    await_all_others_done();
+    CPPA_CHECKPOINT();
+}
+
+void test_chain() {
+    CPPA_PRINT("test token passing along a chain of actors");
+    constexpr int num_chains = 50;
+    s_finished = 0;
+    for (int i = 0; i < num_chains; ++i) {
+        auto next = spawn(chain_link, actor_ptr{});
+        for (int j = 0; j < 20; ++j) next = spawn(chain_link, next);
+        send(next, atom("token"), 20);
+    }
+    await_all_others_done();
+    CPPA_CHECK_EQUAL(s_finished.load(), static_cast<size_t>(num_chains * 21));
+}
+
+void test_throughput_budget(detail::thread_pool_scheduler* sched) {
+    CPPA_PRINT("test preemption of actors after their throughput budget");
+    constexpr int num_msgs = 1000;
+    constexpr int budget = 10;
+    constexpr auto opts = max_throughput(budget) + monitored;
+    static_assert(get_max_throughput(opts) == budget, "invalid encoding");
+    static_assert(get_max_throughput(no_spawn_options) == 0,
+                  "invalid encoding");
+    static_assert(get_max_throughput(max_throughput(2048)) == 2047,
+                  "budget is not clamped");
+    static_assert(get_max_throughput(max_throughput(-1)) == 0,
+                  "budget is not clamped");
+    // fill the mailbox while the only worker is blocked, i.e., the actor
+    // would handle all messages in a single resume without a budget;
+    // the supervisor must not add a worker in the meantime
+    auto num_workers = sched->num_active_workers();
+    sched->adaptive_resizing(false);
+    sched->resize(1);
+    // give retired workers time to stop
+    this_thread::sleep_for(chrono::milliseconds(10));
+    atomic<bool> blocked{false};
+    atomic<bool> released{false};
+    spawn([&] {
+        blocked = true;
+        while (!released) this_thread::yield();
+        self->quit();
+    });
+    while (!blocked) this_thread::yield();
+    auto flooded = spawn<opts>([=] {
+        auto received = std::make_shared<int>(0);
+        become (
+            on(atom("msg")) >> [=] {
+                if (++*received == num_msgs) self->quit();
+            }
+        );
+    });
+    for (int i = 0; i < num_msgs; ++i) send(flooded, atom("msg"));
+    auto jobs = sched->statistics().total().jobs;
+    released = true;
+    receive (
+        on(atom("DOWN"), exit_reason::normal) >> CPPA_CHECKPOINT_CB()
+    );
+    await_all_others_done();
+    jobs = sched->statistics().total().jobs - jobs;
+    CPPA_CHECK(jobs >= static_cast<uint64_t>(num_msgs / budget));
+    sched->resize(num_workers);
+    sched->adaptive_resizing(true);
+}
+
+void test_ping_pong() {
+    CPPA_PRINT("test event-based ping pong");
+    auto ping_actor = spawn(event_based_ping, 1000);
+    spawn(event_based_pong, ping_actor);
+    await_all_others_done();
+    CPPA_CHECK_EQUAL(pongs(), 1000);
+}
+
+void test_resize(detail::thread_pool_scheduler* sched) {
+    CPPA_PRINT("test resizing the thread pool at runtime");
+    auto num_workers = sched->num_active_workers();
+    sched->resize(0); // clamped to min_workers()
+    CPPA_CHECK_EQUAL(sched->num_active_workers(), sched->min_workers());
+    test_fan_out();
+    sched->resize(sched->max_workers());
+    CPPA_CHECK_EQUAL(sched->num_active_workers(), sched->max_workers());
+    test_chain();
+    sched->resize(num_workers);
+}
+
+void test_detached_threads(detail::thread_pool_scheduler* sched) {
+    CPPA_PRINT("test reuse of threads for detached actors");
+    constexpr size_t rounds = 20;
+    constexpr size_t actors_per_round = 10;
+    auto& pool = sched->detached_threads();
+    pool.stack_size(256 * 1024);
+    auto created = pool.created_threads();
+    std::atomic<size_t> finished{0};
+    for (size_t i = 0; i < rounds; ++i) {
+        for (size_t j = 0; j < actors_per_round; ++j) {
+            spawn<detached>([&] { ++finished; });
+        }
+        await_all_others_done();
+        // give threads time to become idle
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+    CPPA_CHECK_EQUAL(finished.load(), rounds * actors_per_round);
+    CPPA_CHECK(pool.created_threads() - created < rounds * actors_per_round);
+    auto stats = get_scheduler()->statistics();
+    CPPA_CHECK(stats.detached_threads > 0);
+    CPPA_CHECK(stats.peak_detached_threads >= stats.detached_threads);
+    CPPA_PRINT(stats.detached_threads << " detached threads, "
+               << (pool.created_threads() - created) << " created");
+}
+
+void test_lifo_slot_stealing(detail::thread_pool_scheduler* sched) {
+    CPPA_PRINT("test that idle workers steal jobs from the LIFO slot");
+    // the test requires at least one worker besides the producer
+    CPPA_CHECK(sched->num_active_workers() > 1);
+    atomic<bool> consumed{false};
+    auto consumer = spawn([&] {
+        become (
+            on(atom("ping")) >> [] {
+                return atom("pong");
+            },
+            on(atom("data")) >> [&] {
+                consumed = true;
+                self->quit();
+            }
+        );
+    });
+    // make sure the consumer waits for messages
+    send(consumer, atom("ping"));
+    receive (
+        on(atom("pong")) >> CPPA_CHECKPOINT_CB()
+    );
+    this_thread::sleep_for(chrono::milliseconds(5));
+    // the producer does not return until the consumer got its message,
+    // i.e., the consumer must not wait in the LIFO slot of the producer
+    spawn([&, consumer] {
+        send(consumer, atom("data"));
+        auto timeout = chrono::steady_clock::now() + chrono::seconds(5);
+        while (!consumed && chrono::steady_clock::now() < timeout) {
+            this_thread::yield();
+        }
+        CPPA_CHECK(consumed.load());
+        self->quit();
+    });
+    await_all_others_done();
+}
+
+// runs jobs of all classes on a single worker that is blocked until
+// all jobs are enqueued and returns the classes in order of execution
+vector<scheduling_priority> run_blocked(detail::thread_pool_scheduler* sched,
+                                        const vector<scheduling_priority>& jobs) {
+    // the supervisor must not add a worker while the only one is blocked
+    auto num_workers = sched->num_active_workers();
+    sched->adaptive_resizing(false);
+    sched->resize(1);
+    // give retired workers time to stop
+    this_thread::sleep_for(chrono::milliseconds(10));
+    mutex mtx;
+    vector<scheduling_priority> result;
+    atomic<bool> blocked{false};
+    atomic<bool> released{false};
+    auto blocker = spawn([&] {
+        blocked = true;
+        while (!released) this_thread::yield();
+        self->quit();
+    });
+    while (!blocked) this_thread::yield();
+    vector<actor_ptr> receivers;
+    for (auto prio : jobs) {
+        auto fun = [&, prio] {
+            become (
+                on(atom("run")) >> [&, prio] {
+                    { // lifetime scope of guard
+                        lock_guard<mutex> guard(mtx);
+                        result.push_back(prio);
+                    }
+                    self->quit();
+                }
+            );
+        };
+        switch (prio) {
+            case scheduling_priority::high:
+                receivers.push_back(spawn<high_scheduling_priority>(fun));
+                break;
+            case scheduling_priority::low:
+                receivers.push_back(spawn<low_scheduling_priority>(fun));
+                break;
+            default:
+                receivers.push_back(spawn(fun));
+        }
+    }
+    for (auto& r : receivers) send(r, atom("run"));
+    released = true;
+    await_all_others_done();
+    sched->resize(num_workers);
+    sched->adaptive_resizing(true);
+    return result;
+}
+
+void test_priority_classes(detail::thread_pool_scheduler* sched) {
+    CPPA_PRINT("test scheduling priority classes");
+    using sp = scheduling_priority;
+    CPPA_CHECK(has_high_priority_flag(high_scheduling_priority + linked));
+    CPPA_CHECK(!has_low_priority_flag(high_scheduling_priority));
+    auto order = run_blocked(sched, {sp::low, sp::normal, sp::high});
+    vector<sp> expected{sp::high, sp::normal, sp::low};
+    CPPA_CHECK(order == expected);
+    // the low job must not wait for all high jobs
+    auto threshold = sched->aging_threshold();
+    sched->aging_threshold(2);
+    order = run_blocked(sched, {sp::low, sp::high, sp::high,
+                                sp::high, sp::high, sp::high});
+    sched->aging_threshold(threshold);
+    auto i = find(order.begin(), order.end(), sp::low);
+    CPPA_CHECK_EQUAL(distance(order.begin(), i), 2);
+}
+
+int main() {
+    CPPA_TEST(test_scheduler);
+    auto sched = new detail::work_stealing_scheduler(4);
+    sched->park_idle_workers(true);
+    sched->spin_budget(10);
+    sched->pin_workers(true);
+    sched->worker_bounds(1, 8);
+    sched->measure_utilization(true);
+    set_scheduler(sched);
+    test_fan_out();
+    test_batch_send();
+    test_chain();
+    test_throughput_budget(sched);
+    test_priority_classes(sched);
+    test_resize(sched);
+    test_detached_threads(sched);
+    // give workers time to park
+    this_thread::sleep_for(chrono::milliseconds(50));
+    test_ping_pong();
+    test_lifo_slot_stealing(sched);
+    CPPA_CHECK(sched->num_wakeups() > 0);
+    auto stats = get_scheduler()->statistics();
+    CPPA_CHECK_EQUAL(stats.workers.size(), sched->max_workers());
+    auto total = stats.total();
+    CPPA_CHECK(total.jobs > 0);
+    CPPA_CHECK(total.messages >= total.jobs / 2);
+    CPPA_CHECK(total.busy.count() > 0);
+    CPPA_PRINT(to_string(stats));
+    CPPA_PRINT("wake-up latency: avg = "
+               << sched->avg_wakeup_latency().count() << "ns, max = "
+               << sched->max_wakeup_latency().count() << "ns");
+    shutdown();
+    return CPPA_TEST_RESULT();
+}
@@ -1,6 +1,9 @@
 #include <stack>
+#include <atomic>
 #include <chrono>
+#include <thread>
 #include <iostream>
+#include <algorithm>
 #include <functional>
 
 #include "test.hpp"
@@ -15,6 +18,7 @@
 #include "cppa/to_string.hpp"
 #include "cppa/exit_reason.hpp"
 #include "cppa/util/type_traits.hpp"
+#include "cppa/detail/actor_registry.hpp"
 #include "cppa/event_based_actor.hpp"
 
 using namespace std;
@@ -464,9 +468,180 @@ void test_continuation() {
     await_all_others_done();
 }
 
+// waits until released before it reads all messages and
+// sends {'result', count, first, last} to client afterwards
+void bounded_receiver(atomic<bool>* released, actor_ptr client) {
+    while (!*released) this_thread::sleep_for(chrono::milliseconds(1));
+    int count = 0;
+    int first = -1;
+    int last = -1;
+    for (bool done = false; !done; ) {
+        receive (
+            on_arg_match >> [&](int value) {
+                if (count++ == 0) first = value;
+                last = value;
+            },
+            after(chrono::milliseconds(100)) >> [&] {
+                done = true;
+            }
+        );
+    }
+    send(client, atom("result"), count, first, last);
+}
+
+// sends num_msgs messages to a blocked receiver that discards num_dropped
+// of them on arrival and expects the receiver to read count messages,
+// starting with first and ending with last
+template<spawn_options Os>
+void test_mailbox_overflow(int num_msgs, int num_dropped,
+                           int count, int first, int last) {
+    // senders enqueue up to twice the capacity (see mailbox_overflow)
+    auto hard_limit = 2 * get_mailbox_capacity(Os);
+    // drop_newest only notifies senders of synchronous requests
+    auto policy = get_mailbox_overflow(Os);
+    auto num_overflows = policy == mailbox_overflow::drop_newest ? 0
+                                                                 : num_dropped;
+    atomic<bool> released{false};
+    auto receiver = spawn<Os>(bounded_receiver, &released, self);
+    for (int i = 0; i < num_msgs; ++i) send(receiver, i);
+    CPPA_CHECK(receiver->mailbox_size() <= hard_limit);
+    CPPA_CHECK_EQUAL(receiver->mailbox_size(),
+                     static_cast<size_t>(num_msgs - num_dropped));
+    int overflows = 0;
+    for (int i = 0; i < num_overflows; ++i) {
+        receive (
+            on(atom("OVERFLOW"), receiver) >> [&] { ++overflows; }
+        );
+    }
+    released = true;
+    receive (
+        on(atom("result"), count, first, last) >> CPPA_CHECKPOINT_CB(),
+        others() >> CPPA_UNEXPECTED_MSG_CB()
+    );
+    CPPA_CHECK_EQUAL(overflows, num_overflows);
+    await_all_others_done();
+}
+
+void test_bounded_mailboxes() {
+    constexpr auto opts = detached + blocking_api;
+    CPPA_CHECK_EQUAL(get_mailbox_capacity(bounded_mailbox(10)), 10u);
+    CPPA_CHECK(get_mailbox_capacity(opts) == 0);
+    using mo = mailbox_overflow;
+    test_mailbox_overflow<opts + bounded_mailbox(10)>(20, 10, 10, 0, 9);
+    test_mailbox_overflow<opts + bounded_mailbox(10, mo::drop_oldest)>(
+        30, 10, 10, 10, 19);
+    test_mailbox_overflow<opts + bounded_mailbox(10, mo::reject)>(
+        20, 10, 10, 0, 9);
+    // this thread cannot be suspended, i.e., its messages are rejected
+    test_mailbox_overflow<opts + bounded_mailbox(10, mo::suspend_sender)>(
+        20, 10, 10, 0, 9);
+    // an event-based sender waits for the receiver, but finishes its
+    // current message first; messages above twice the capacity are rejected
+    atomic<bool> released{false};
+    auto receiver = spawn<opts + bounded_mailbox(10, mo::suspend_sender)>(
+                        bounded_receiver, &released, self);
+    actor_ptr client = self;
+    auto sender = spawn([=] {
+        auto overflows = std::make_shared<int>(0);
+        become (
+            on(atom("produce")) >> [=] {
+                for (int i = 0; i < 30; ++i) send(receiver, i);
+            },
+            on(atom("OVERFLOW"), receiver) >> [=] {
+                ++*overflows;
+            },
+            on(atom("report")) >> [=] {
+                send(client, atom("reported"));
+            },
+            on(atom("overflows")) >> [=] {
+                // all OVERFLOW messages arrived before this message
+                send(client, atom("overflows"), *overflows);
+                self->quit();
+            }
+        );
+    });
+    send(sender, atom("produce"));
+    send(sender, atom("report"));
+    receive (
+        on(atom("reported")) >> CPPA_UNEXPECTED_MSG_CB(),
+        after(chrono::milliseconds(50)) >> CPPA_CHECKPOINT_CB()
+    );
+    CPPA_CHECK_EQUAL(receiver->mailbox_size(), 20u);
+    auto largest = get_actor_registry()->largest_mailboxes(1);
+    CPPA_CHECK_EQUAL(largest.size(), 1u);
+    if (!largest.empty()) {
+        CPPA_CHECK_EQUAL(largest.front().id, receiver->id());
+        CPPA_CHECK_EQUAL(largest.front().size, 20u);
+        CPPA_CHECK_EQUAL(largest.front().enqueued, 20u);
+    }
+    released = true;
+    receive (
+        on(atom("reported")) >> CPPA_CHECKPOINT_CB()
+    );
+    send(sender, atom("overflows"));
+    receive (
+        on(atom("overflows"), arg_match) >> [](int overflows) {
+            CPPA_CHECK_EQUAL(overflows, 10);
+        }
+    );
+    receive (
+        on(atom("result"), 20, 0, 19) >> CPPA_CHECKPOINT_CB(),
+        others() >> CPPA_UNEXPECTED_MSG_CB()
+    );
+    await_all_others_done();
+}
+
+template<spawn_options Os>
+void test_batch_delivery(size_t max_batch_size) {
+    actor_ptr client = self;
+    // the consumer blocks in its first handler until all messages are
+    // in its mailbox, i.e., on_batch finds more than one message
+    auto filled = std::make_shared<atomic<bool>>(false);
+    auto consumer = spawn<Os>([=] {
+        // batches preserve message order, i.e., we receive 0..9
+        auto next = std::make_shared<int>(0);
+        auto batch_sizes = std::make_shared<vector<size_t>>();
+        become (
+            on(atom("wait")) >> [=] {
+                while (!*filled) this_thread::yield();
+            },
+            on_batch<int>(4) >> [=](const vector<int>& xs) {
+                batch_sizes->push_back(xs.size());
+                for (auto x : xs) {
+                    CPPA_CHECK_EQUAL(x, *next);
+                    ++*next;
+                }
+            },
+            on(atom("done")) >> [=] {
+                auto& sizes = *batch_sizes;
+                auto largest = *max_element(sizes.begin(), sizes.end());
+                send(client, atom("result"), *next, largest);
+                self->quit();
+            }
+        );
+    });
+    send(consumer, atom("wait"));
+    for (int i = 0; i < 10; ++i) send(consumer, i);
+    send(consumer, atom("done"));
+    *filled = true;
+    receive (
+        on(atom("result"), 10, arg_match) >> [&](size_t largest) {
+            CPPA_CHECK(largest > 1);
+            CPPA_CHECK(largest <= max_batch_size);
+        },
+        others() >> CPPA_UNEXPECTED_MSG_CB()
+    );
+    await_all_others_done();
+}
+
 int main() {
     CPPA_TEST(test_spawn);
 
+    test_bounded_mailboxes();
+    test_batch_delivery<no_spawn_options>(4);
+    // a batch never exceeds the throughput budget of the actor
+    test_batch_delivery<max_throughput(2)>(2);
+
     test_serial_reply();
     test_or_else();
     test_continuation();